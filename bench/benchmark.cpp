@@ -0,0 +1,416 @@
+#include "../include/TechnicalIndicator.h"
+#include "../include/IndicatorGrid.h"
+#include "../include/IndicatorPipeline.h"
+#include "../include/PrecisionIndicators.h"
+#include "../include/CorrelationEngine.h"
+#include "../include/RingQueues.h"
+#include "../include/ThreadSafeQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Per-kernel microbenchmarks. Every benchmark runs a few untimed warmup
+// iterations, then times each repetition separately so the report carries
+// the distribution (median, p95, p99) rather than a single mean.
+// Snapshot kernels only read the trailing window of each series, so they
+// report symbols/s; the full-series path reports bars/s.
+
+namespace {
+
+struct Options {
+    int warmup = 3;
+    int repeats = 30;
+    int symbols = 2000;
+    int bars = 1000;
+    size_t queueItems = 200000;
+    std::string jsonPath;
+    std::string filter;
+};
+
+struct Result {
+    std::string name;
+    std::string unit;
+    double unitsPerRun;
+    std::vector<double> samplesNs;
+    double medianNs;
+    double p95Ns;
+    double p99Ns;
+    double minNs;
+    double meanNs;
+    double stddevNs;
+
+    double throughput() const { return medianNs > 0 ? unitsPerRun / (medianNs * 1e-9) : 0.0; }
+};
+
+constexpr size_t kBatch = 64;
+
+// Keeps results observable so the optimizer cannot drop the timed work.
+volatile double gSink = 0.0;
+
+// Nearest-rank percentile of an ascending sample vector.
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+Result measure(const Options& options, const std::string& name, const std::string& unit,
+               double unitsPerRun, const std::function<void()>& body) {
+    for (int i = 0; i < options.warmup; ++i) {
+        body();
+    }
+
+    Result result{name, unit, unitsPerRun, {}, 0, 0, 0, 0, 0, 0};
+    result.samplesNs.reserve(options.repeats);
+    for (int i = 0; i < options.repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        result.samplesNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    std::vector<double> sorted = result.samplesNs;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double sample : sorted) {
+        sum += sample;
+    }
+    result.meanNs = sum / sorted.size();
+    double variance = 0.0;
+    for (double sample : sorted) {
+        variance += (sample - result.meanNs) * (sample - result.meanNs);
+    }
+    result.stddevNs = sorted.size() > 1 ? std::sqrt(variance / (sorted.size() - 1)) : 0.0;
+    result.minNs = sorted.front();
+    result.medianNs = percentile(sorted, 50.0);
+    result.p95Ns = percentile(sorted, 95.0);
+    result.p99Ns = percentile(sorted, 99.0);
+    return result;
+}
+
+std::vector<TechnicalIndicator::StockData> generateUniverse(int numSymbols, int bars) {
+    std::mt19937 gen(42);
+    std::normal_distribution<double> returns(0.0, 0.01);
+    std::uniform_real_distribution<double> volumeDist(1000000.0, 10000000.0);
+
+    std::vector<TechnicalIndicator::StockData> stocks(numSymbols);
+    for (int i = 0; i < numSymbols; ++i) {
+        auto& stock = stocks[i];
+        stock.symbol = "BENCH" + std::to_string(i);
+        stock.symbolId = SymbolTable::global().intern(stock.symbol);
+        stock.prices.reserve(bars);
+        double price = 100.0;
+        for (int day = 0; day < bars; ++day) {
+            price *= 1.0 + returns(gen);
+            stock.prices.push_back(price);
+            stock.volumes.push_back(volumeDist(gen));
+            stock.timestamps.push_back(day);
+        }
+    }
+    return stocks;
+}
+
+// One producer pushes, one consumer pops, both in batches; times the whole
+// transfer of items through the queue.
+void transfer(ConcurrentQueue<TechnicalIndicator::IndicatorResult>& queue, size_t items) {
+    queue.reset();
+    std::thread producer([&queue, items] {
+        std::vector<TechnicalIndicator::IndicatorResult> batch(kBatch);
+        for (size_t i = 0; i < kBatch; ++i) {
+            batch[i] = TechnicalIndicator::IndicatorResult{};
+            batch[i].symbolId = static_cast<SymbolTable::Id>(i);
+        }
+        for (size_t sent = 0; sent < items; sent += kBatch) {
+            queue.pushBulk(batch.data(), std::min(kBatch, items - sent));
+        }
+    });
+
+    std::vector<TechnicalIndicator::IndicatorResult> out(kBatch);
+    size_t received = 0;
+    double checksum = 0.0;
+    while (received < items) {
+        size_t count = queue.waitPopBulk(out.data(), out.size(), std::chrono::milliseconds(10));
+        for (size_t i = 0; i < count; ++i) {
+            checksum += out[i].symbolId;
+        }
+        received += count;
+    }
+    producer.join();
+    gSink = gSink + checksum;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeJson(std::ostream& out, const Options& options, int threads,
+               const std::vector<Result>& results) {
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n"
+        << "  \"config\": {\"warmup\": " << options.warmup << ", \"repeats\": " << options.repeats
+        << ", \"symbols\": " << options.symbols << ", \"bars\": " << options.bars
+        << ", \"queue_items\": " << options.queueItems << ", \"threads\": " << threads
+        << ", \"simd\": \"" << SimdKernels::levelName(SimdKernels::activeLevel()) << "\"},\n"
+        << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"unit\": \"" << r.unit
+            << "\", \"units_per_run\": " << r.unitsPerRun
+            << ", \"median_ns\": " << r.medianNs << ", \"p95_ns\": " << r.p95Ns
+            << ", \"p99_ns\": " << r.p99Ns << ", \"min_ns\": " << r.minNs
+            << ", \"mean_ns\": " << r.meanNs << ", \"stddev_ns\": " << r.stddevNs
+            << ", \"throughput_per_s\": " << r.throughput() << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void printTable(const std::vector<Result>& results) {
+    std::cout << std::left << std::setw(34) << "Benchmark"
+              << std::right << std::setw(12) << "median ms"
+              << std::setw(12) << "p95 ms"
+              << std::setw(12) << "p99 ms"
+              << std::setw(10) << "cv %"
+              << std::setw(18) << "throughput" << "\n";
+    std::cout << std::string(98, '-') << "\n";
+    for (const Result& r : results) {
+        double cv = r.meanNs > 0 ? 100.0 * r.stddevNs / r.meanNs : 0.0;
+        std::cout << std::left << std::setw(34) << r.name << std::right << std::fixed
+                  << std::setprecision(3)
+                  << std::setw(12) << r.medianNs / 1e6
+                  << std::setw(12) << r.p95Ns / 1e6
+                  << std::setw(12) << r.p99Ns / 1e6
+                  << std::setprecision(1) << std::setw(10) << cv
+                  << std::setprecision(3) << std::setw(12) << r.throughput() / 1e6
+                  << " M" << r.unit << "/s\n";
+    }
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--warmup N] [--repeats N] [--symbols N] [--bars N]\n"
+              << "       [--queue-items N] [--filter substring] [--json out.json]\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--warmup") options.warmup = std::stoi(value);
+        else if (arg == "--repeats") options.repeats = std::max(1, std::stoi(value));
+        else if (arg == "--symbols") options.symbols = std::max(1, std::stoi(value));
+        else if (arg == "--bars") options.bars = std::max(1, std::stoi(value));
+        else if (arg == "--queue-items") options.queueItems = std::stoul(value);
+        else if (arg == "--filter") options.filter = value;
+        else if (arg == "--json") options.jsonPath = value;
+        else return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int threads = 1;
+    #ifdef _OPENMP
+    threads = omp_get_max_threads();
+    #endif
+
+    auto stocks = generateUniverse(options.symbols, options.bars);
+    const double symbols = static_cast<double>(options.symbols);
+    const double bars = symbols * options.bars;
+    TechnicalIndicator indicator;
+
+    // Indicator inputs for the signal benchmark, computed once up front
+    std::vector<TechnicalIndicator::IndicatorResult> snapshots =
+        indicator.computeIndicatorsParallel(stocks);
+
+    std::vector<double> seriesBuffer(5 * static_cast<size_t>(options.bars));
+    TechnicalIndicator::IndicatorSeries series{
+        seriesBuffer.data(), seriesBuffer.data() + options.bars,
+        seriesBuffer.data() + 2 * options.bars, seriesBuffer.data() + 3 * options.bars,
+        seriesBuffer.data() + 4 * options.bars};
+
+    // Same universe at double and float storage for the precision scans
+    auto doubleStore = ColumnarPriceStore::fromStockData(stocks);
+    auto floatStore = FloatPriceStore::fromStockData(stocks);
+    std::vector<float> floatSeriesBuffer(5 * static_cast<size_t>(options.bars));
+    PrecisionIndicators<SinglePrecision>::Series floatSeries{
+        floatSeriesBuffer.data(), floatSeriesBuffer.data() + options.bars,
+        floatSeriesBuffer.data() + 2 * options.bars, floatSeriesBuffer.data() + 3 * options.bars,
+        floatSeriesBuffer.data() + 4 * options.bars};
+
+    // 8 x 8 x 8 grid: 4096 (short, long, RSI, MACD) combinations per symbol
+    IndicatorGrid::Spec gridSpec;
+    for (int i = 0; i < 8; ++i) {
+        gridSpec.smaPeriods.push_back(10 + 10 * i);
+        gridSpec.rsiPeriods.push_back(7 + 2 * i);
+        gridSpec.macdParams.push_back({8 + i, 21 + 2 * i, 9});
+    }
+    IndicatorGrid grid(gridSpec);
+
+    // Return correlation over up to a year of bars, all symbol pairs
+    CorrelationEngine correlation(std::max(2, std::min(252, options.bars - 1)));
+    const double pairs = symbols * (symbols + 1) / 2;
+
+    SpscRingQueue<TechnicalIndicator::IndicatorResult> spsc(4096);
+    MpmcRingQueue<TechnicalIndicator::IndicatorResult> mpmc(4096);
+    ThreadSafeQueue<TechnicalIndicator::IndicatorResult> locking;
+
+    struct Case {
+        std::string name;
+        std::string unit;
+        double units;
+        std::function<void()> body;
+    };
+    std::vector<Case> cases = {
+        {"sma20+sma50", "symbols", symbols, [&] {
+            double sum = 0.0;
+            for (const auto& stock : stocks) {
+                sum += indicator.calculateSMA(stock.prices.data(), stock.prices.size(), 20);
+                sum += indicator.calculateSMA(stock.prices.data(), stock.prices.size(), 50);
+            }
+            gSink = gSink + sum;
+        }},
+        {"rsi14", "symbols", symbols, [&] {
+            double sum = 0.0;
+            for (const auto& stock : stocks) {
+                sum += indicator.calculateRSI(stock.prices.data(), stock.prices.size(), 14);
+            }
+            gSink = gSink + sum;
+        }},
+        {"macd", "symbols", symbols, [&] {
+            double sum = 0.0;
+            for (const auto& stock : stocks) {
+                sum += indicator.calculateMACD(stock.prices.data(), stock.prices.size()).first;
+            }
+            gSink = gSink + sum;
+        }},
+        {"signal+strength", "symbols", static_cast<double>(snapshots.size()), [&] {
+            double sum = 0.0;
+            for (const auto& r : snapshots) {
+                sum += static_cast<int>(TechnicalIndicator::classifySignal(
+                    r.sma_20, r.sma_50, r.rsi, r.macd, r.macd_signal));
+                sum += TechnicalIndicator::calculateSignalStrength(
+                    r.sma_20, r.sma_50, r.rsi, r.macd, r.macd_signal);
+            }
+            gSink = gSink + sum;
+        }},
+        {"computeIndicators (sequential)", "symbols", symbols, [&] {
+            double sum = 0.0;
+            for (const auto& stock : stocks) {
+                sum += indicator.computeIndicators(stock).rsi;
+            }
+            gSink = gSink + sum;
+        }},
+        {"computeIndicatorsParallel", "symbols", symbols, [&] {
+            auto results = indicator.computeIndicatorsParallel(stocks);
+            gSink = gSink + results.back().rsi;
+        }},
+        {"IndicatorPipeline (fused, parallel)", "symbols", symbols, [&] {
+            using Pipeline = IndicatorPipeline<SMA<20>, SMA<50>, RSI<14>, MACD<12, 26, 9>>;
+            auto results = indicator.computeIndicatorsParallel<Pipeline>(stocks);
+            gSink = gSink + results.back().get<RSI<14>>();
+        }},
+        {"computeIndicatorSeries", "bars", bars, [&] {
+            for (const auto& stock : stocks) {
+                indicator.computeIndicatorSeries(stock, series);
+            }
+            gSink = gSink + series.rsi[options.bars - 1];
+        }},
+        {"precision scan double", "symbols", symbols, [&] {
+            auto results = PrecisionIndicators<DoublePrecision>::computeParallel(doubleStore);
+            gSink = gSink + results.back().rsi;
+        }},
+        {"precision scan mixed (float/double)", "symbols", symbols, [&] {
+            auto results = PrecisionIndicators<MixedPrecision>::computeParallel(floatStore);
+            gSink = gSink + results.back().rsi;
+        }},
+        {"precision scan single (float)", "symbols", symbols, [&] {
+            auto results = PrecisionIndicators<SinglePrecision>::computeParallel(floatStore);
+            gSink = gSink + results.back().rsi;
+        }},
+        {"computeIndicatorSeries single (float)", "bars", bars, [&] {
+            for (size_t i = 0; i < floatStore.size(); ++i) {
+                PrecisionIndicators<SinglePrecision>::computeSeries(
+                    floatStore.prices(i), floatStore.length(i), floatSeries);
+            }
+            gSink = gSink + floatSeries.rsi[options.bars - 1];
+        }},
+        {"computeExtendedIndicators (fused)", "bars", bars, [&] {
+            double sum = 0.0;
+            for (const auto& stock : stocks) {
+                sum += indicator.computeExtendedIndicators(stock).atr;
+            }
+            gSink = gSink + sum;
+        }},
+        {"indicator grid 8x8x8", "bars", bars, [&] {
+            auto result = grid.compute(stocks);
+            gSink = gSink + result.rsi.back();
+        }},
+        {"correlation matrix", "pairs", pairs, [&] {
+            correlation.compute(stocks);
+            gSink = gSink + correlation.covariance(0, 0);
+        }},
+        {"queue spsc push/pop", "items", static_cast<double>(options.queueItems), [&] {
+            transfer(spsc, options.queueItems);
+        }},
+        {"queue mpmc push/pop", "items", static_cast<double>(options.queueItems), [&] {
+            transfer(mpmc, options.queueItems);
+        }},
+        {"queue locking push/pop", "items", static_cast<double>(options.queueItems), [&] {
+            transfer(locking, options.queueItems);
+        }},
+    };
+
+    std::cout << "=== Kernel Microbenchmarks ===\n"
+              << options.symbols << " symbols x " << options.bars << " bars, "
+              << options.warmup << " warmup + " << options.repeats << " timed runs, "
+              << threads << " threads, SIMD " << SimdKernels::levelName(SimdKernels::activeLevel())
+              << "\n\n";
+
+    std::vector<Result> results;
+    for (const Case& c : cases) {
+        if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(measure(options, c.name, c.unit, c.units, c.body));
+    }
+    printTable(results);
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream out(options.jsonPath);
+        if (!out) {
+            std::cerr << "Error: cannot write " << options.jsonPath << "\n";
+            return 1;
+        }
+        writeJson(out, options, threads, results);
+        std::cout << "\nJSON written to " << options.jsonPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#ifndef BACKTESTER_H
+#define BACKTESTER_H
+
+#include "TechnicalIndicator.h"
+#include <cstddef>
+#include <vector>
+
+// Walk-forward backtest of the BUY/SELL/HOLD rules (classifySignal and
+// calculateSignalStrength) over each symbol's history. Indicators advance
+// one bar at a time through IncrementalIndicator, so a run is O(bars) with
+// no recomputation from scratch.
+//
+// A signal seen at the close of bar t is filled at the close of bar t+1,
+// so no decision uses a price it could not have known. BUY targets a long
+// position, SELL a short one (or flat when shorting is off), HOLD keeps
+// the current position; a position is only traded when its direction
+// changes. Open positions are closed at the last bar so every trade is
+// realized in the report.
+//
+// Runs are parallel over (symbol x parameter block), and one indicator
+// stream per task drives every parameter set in its block.
+class Backtester {
+public:
+    static constexpr size_t kParamBlock = 8;
+
+    enum class Sizing {
+        Fixed,          // positionFraction of equity on every entry
+        StrengthScaled  // scaled by min(1, signal_strength / strengthScale)
+    };
+
+    struct Params {
+        double initialCapital = 100000.0;
+        double positionFraction = 1.0;
+        Sizing sizing = Sizing::Fixed;
+        double strengthScale = 10.0;
+        // Signals weaker than this are treated as HOLD.
+        double minStrength = 0.0;
+        // Commission plus slippage, charged on the traded notional.
+        double costBps = 5.0;
+        bool allowShort = false;
+        // No entries before this many bars, so indicators are warmed up.
+        size_t warmupBars = 50;
+    };
+
+    struct Report {
+        SymbolTable::Id symbolId = SymbolTable::kInvalidId;
+        size_t params = 0;          // index into the parameter sets
+        size_t bars = 0;
+        double finalEquity = 0.0;
+        double pnl = 0.0;
+        double totalReturn = 0.0;
+        double maxDrawdown = 0.0;   // largest peak-to-trough fall, fraction of peak
+        double costs = 0.0;
+        size_t trades = 0;          // closed round trips
+        size_t winningTrades = 0;
+        double hitRate() const { return trades > 0 ? static_cast<double>(winningTrades) / trades : 0.0; }
+    };
+
+    Report run(const TechnicalIndicator::PriceSeriesView& series, const Params& params) const;
+
+    // Row-major: report[s * params.size() + p] is symbol s under params[p].
+    std::vector<Report> run(const std::vector<TechnicalIndicator::PriceSeriesView>& series,
+                            const std::vector<Params>& params) const;
+    std::vector<Report> run(const std::vector<TechnicalIndicator::StockData>& stocks,
+                            const std::vector<Params>& params) const;
+
+private:
+    void runBlock(const TechnicalIndicator::PriceSeriesView& series, const Params* params,
+                  size_t count, size_t firstIndex, Report* out) const;
+};
+
+#endif
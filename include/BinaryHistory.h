@@ -0,0 +1,91 @@
+#ifndef BINARY_HISTORY_H
+#define BINARY_HISTORY_H
+
+#include "TechnicalIndicator.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// On-disk columnar history format (native byte order, little-endian hosts):
+//
+//   FileHeader                       64 bytes at offset 0
+//   DirectoryEntry[numSymbols]       64 bytes each, starting at directoryOffset
+//   per symbol, each 64-byte aligned:
+//     double prices[length]
+//     double volumes[length]
+//     double timestamps[length]
+//
+// Every column starts on a cache-line boundary, so a mapped file can be read
+// in place: MappedHistory hands out PriceSeriesViews pointing straight into
+// the mapping and loading costs page faults rather than parsing.
+class BinaryHistory {
+public:
+    static constexpr char kMagic[8] = {'S', 'T', 'K', 'H', 'I', 'S', 'T', '1'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrderMark = 0x01020304;
+    static constexpr size_t kSymbolCapacity = 32;
+    static constexpr size_t kColumnAlignment = 64;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrderMark;
+        uint64_t numSymbols;
+        uint64_t totalBars;
+        uint64_t directoryOffset;
+        uint64_t fileSize;
+        uint64_t reserved[2];
+    };
+
+    struct DirectoryEntry {
+        char symbol[kSymbolCapacity];
+        uint64_t length;
+        uint64_t pricesOffset;
+        uint64_t volumesOffset;
+        uint64_t timestampsOffset;
+    };
+
+    // Writes stocks to path, replacing any existing file. Missing volume or
+    // timestamp columns are written as zeros. Throws std::runtime_error on
+    // I/O failure or a symbol longer than kSymbolCapacity - 1 characters.
+    static void write(const std::string& path,
+                      const std::vector<TechnicalIndicator::StockData>& stocks);
+};
+
+static_assert(sizeof(BinaryHistory::FileHeader) == 64, "FileHeader must stay 64 bytes");
+static_assert(sizeof(BinaryHistory::DirectoryEntry) == 64, "DirectoryEntry must stay 64 bytes");
+
+// Read-only memory mapping of a BinaryHistory file. Views stay valid for
+// the lifetime of the MappedHistory object; symbols are interned on open,
+// so views carry their symbolId.
+class MappedHistory {
+public:
+    explicit MappedHistory(const std::string& path);
+    ~MappedHistory();
+
+    MappedHistory(const MappedHistory&) = delete;
+    MappedHistory& operator=(const MappedHistory&) = delete;
+
+    size_t size() const { return numSymbols_; }
+    size_t totalBars() const;
+    size_t mappedBytes() const { return mappedBytes_; }
+
+    TechnicalIndicator::PriceSeriesView series(size_t index) const;
+    std::vector<TechnicalIndicator::PriceSeriesView> views() const;
+    // Returns size() when the symbol is not present.
+    size_t find(std::string_view symbol) const;
+
+    // Asks the kernel to start reading the whole file ahead of use.
+    void prefetch() const;
+
+private:
+    const BinaryHistory::DirectoryEntry& entry(size_t index) const;
+
+    const unsigned char* base_;
+    size_t mappedBytes_;
+    size_t numSymbols_;
+    std::vector<SymbolTable::Id> symbolIds_;
+};
+
+#endif
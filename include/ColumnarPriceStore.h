@@ -0,0 +1,55 @@
+#ifndef COLUMNAR_PRICE_STORE_H
+#define COLUMNAR_PRICE_STORE_H
+
+#include "AlignedAllocator.h"
+#include "TechnicalIndicator.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Price history for a whole universe in one contiguous arena. Series are
+// stored back to back; offsets_[i]..offsets_[i + 1] delimits symbol i, so a
+// batch pass walks memory linearly instead of chasing one heap block per
+// symbol. T is the storage precision: input prices are rounded to it on
+// insert, so FloatPriceStore holds the same universe in half the memory.
+// Symbols are interned once on insert; batch passes read symbolId().
+template<typename T>
+class BasicColumnarPriceStore {
+public:
+    using value_type = T;
+
+    BasicColumnarPriceStore();
+
+    static BasicColumnarPriceStore fromStockData(
+        const std::vector<TechnicalIndicator::StockData>& stocks);
+
+    void reserve(size_t numSymbols, size_t totalPrices);
+    size_t addSeries(const std::string& symbol, const double* prices, size_t length,
+                     SymbolTable::Id symbolId = SymbolTable::kInvalidId);
+    void clear();
+
+    size_t size() const { return symbols_.size(); }
+    size_t totalPrices() const { return offsets_.back(); }
+
+    const std::string& symbol(size_t index) const { return symbols_[index]; }
+    SymbolTable::Id symbolId(size_t index) const { return symbolIds_[index]; }
+    const T* prices(size_t index) const { return arena_.data() + offsets_[index]; }
+    size_t length(size_t index) const { return offsets_[index + 1] - offsets_[index]; }
+
+    const AlignedVector<T>& arena() const { return arena_; }
+    const std::vector<size_t>& offsets() const { return offsets_; }
+
+private:
+    std::vector<std::string> symbols_;
+    std::vector<SymbolTable::Id> symbolIds_;
+    std::vector<size_t> offsets_;
+    AlignedVector<T> arena_;
+};
+
+extern template class BasicColumnarPriceStore<double>;
+extern template class BasicColumnarPriceStore<float>;
+
+using ColumnarPriceStore = BasicColumnarPriceStore<double>;
+using FloatPriceStore = BasicColumnarPriceStore<float>;
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+// Common interface of the inter-thread queues so that Scheduler can pick an
+// implementation at construction time. Bounded implementations block in
+// push()/pushBulk() while full; every blocking call returns early once the
+// queue is stopped.
+template<typename T>
+class ConcurrentQueue {
+public:
+    virtual ~ConcurrentQueue() = default;
+
+    virtual void push(const T& item) = 0;
+    virtual void push(T&& item) = 0;
+    // Returns the number of items enqueued, which is short only after stop().
+    virtual size_t pushBulk(const T* items, size_t count) = 0;
+    // As pushBulk, but moves from items; the enqueued ones are left
+    // moved-from.
+    virtual size_t pushBulkMove(T* items, size_t count) = 0;
+
+    virtual std::optional<T> tryPop() = 0;
+    // Non-blocking; moves up to maxItems into out and returns how many.
+    virtual size_t popBulk(T* out, size_t maxItems) = 0;
+    // Blocks until at least one item is available, the timeout expires or
+    // the queue is stopped.
+    virtual size_t waitPopBulk(T* out, size_t maxItems,
+                               std::chrono::nanoseconds timeout) = 0;
+
+    virtual bool empty() const = 0;
+    virtual size_t size() const = 0;
+
+    virtual void stop() = 0;
+    virtual void reset() = 0;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef CORRELATION_ENGINE_H
+#define CORRELATION_ENGINE_H
+
+#include "AlignedAllocator.h"
+#include "TechnicalIndicator.h"
+#include <cstddef>
+#include <vector>
+
+// Cross-sectional covariance and correlation of simple returns over a
+// rolling window of bars, for a universe of N symbols with aligned bars.
+//
+// compute() takes the last window+1 closes of each symbol and forms all
+// N(N+1)/2 distinct pairwise sums in a tiled kernel: tiles of kTile x kTile
+// symbol pairs on or above the diagonal are spread over OpenMP threads,
+// the return axis is walked in kDepth chunks so both tiles' rows stay in
+// cache, and each 4x4 block of pairs is accumulated in registers. Only the
+// upper triangle is computed and stored (packed); accessors mirror it.
+//
+// update() slides the window by one bar in O(N^2) by adding the new
+// return's products and subtracting the oldest one's. Returns are kept
+// shifted by their mean as of the last full rebuild, which keeps the
+// running sums well conditioned; the sums are rebuilt from the stored
+// returns once per window of updates so rounding cannot accumulate.
+class CorrelationEngine {
+public:
+    static constexpr size_t kTile = 64;
+    static constexpr size_t kDepth = 128;
+
+    // window is the number of returns per estimate (at least 2).
+    explicit CorrelationEngine(size_t window);
+
+    // Every series needs at least window+1 prices; throws
+    // std::invalid_argument otherwise. Only the tail is read.
+    void compute(const std::vector<TechnicalIndicator::StockData>& stocks);
+    void compute(const std::vector<TechnicalIndicator::PriceSeriesView>& series);
+
+    // One new close per symbol, in compute() order.
+    void update(const std::vector<double>& closes);
+
+    size_t size() const { return size_; }
+    size_t window() const { return window_; }
+
+    // Sample covariance (divided by window - 1).
+    double covariance(size_t i, size_t j) const;
+    // 0 when either series has zero variance.
+    double correlation(size_t i, size_t j) const;
+
+    // Dense row-major N x N copies.
+    std::vector<double> covarianceMatrix() const;
+    std::vector<double> correlationMatrix() const;
+
+private:
+    size_t packedIndex(size_t i, size_t j) const {
+        return i * size_ - i * (i - 1) / 2 + (j - i);  // requires i <= j
+    }
+    void rebuild();
+
+    size_t window_;
+    size_t size_ = 0;
+    size_t stride_ = 0;        // padded row length of returns_
+    // Raw returns, one row per symbol; column head_ is the oldest.
+    AlignedVector<double> returns_;
+    size_t head_ = 0;
+    size_t updatesSinceRebuild_ = 0;
+    std::vector<double> lastClose_;
+    std::vector<double> shift_;      // per-symbol mean at the last rebuild
+    std::vector<double> sums_;       // sum of (return - shift) over the window
+    std::vector<double> products_;   // packed upper triangle of shifted cross sums
+};
+
+#endif
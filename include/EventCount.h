@@ -0,0 +1,84 @@
+#ifndef EVENT_COUNT_H
+#define EVENT_COUNT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Lets lock-free structures block without polling. A waiter calls
+// prepareWait(), re-checks its condition, and then either cancelWait()s or
+// wait()s on the returned key. notifyAll() is a single atomic load when
+// nobody is waiting, so producers only pay for a wakeup when one is needed.
+// On Linux the wait is a futex on the sequence word; elsewhere it falls
+// back to a mutex and condition variable.
+class EventCount {
+public:
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    uint32_t prepareWait() {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return sequence_.load(std::memory_order_seq_cst);
+    }
+
+    void cancelWait() {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Returns once notified, on timeout, or spuriously; callers re-check.
+    void wait(uint32_t key, std::chrono::nanoseconds timeout) {
+#if defined(__linux__)
+        if (timeout.count() > 0) {
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(seconds.count());
+            ts.tv_nsec = static_cast<long>((timeout - seconds).count());
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence_),
+                    FUTEX_WAIT_PRIVATE, key, &ts, nullptr, 0);
+        }
+#else
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait_for(lock, timeout, [this, key] {
+            return sequence_.load(std::memory_order_relaxed) != key;
+        });
+#endif
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notifyAll() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+#if defined(__linux__)
+        sequence_.fetch_add(1, std::memory_order_seq_cst);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence_),
+                FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#else
+        std::lock_guard<std::mutex> lock(mutex_);
+        sequence_.fetch_add(1, std::memory_order_seq_cst);
+        condition_.notify_all();
+#endif
+    }
+
+private:
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<uint32_t> waiters_{0};
+#if !defined(__linux__)
+    std::mutex mutex_;
+    std::condition_variable condition_;
+#endif
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef INCREMENTAL_INDICATOR_H
+#define INCREMENTAL_INDICATOR_H
+
+#include "TechnicalIndicator.h"
+#include <array>
+#include <string>
+
+// Streaming indicator state for one symbol. Each push() folds a new price
+// into running sums and recurrences in constant time:
+//   - SMA20/SMA50 from a ring buffer of the last 50 prices and two running
+//     sums (re-summed once per ring wrap to cancel floating-point drift),
+//   - RSI14 with Wilder smoothing, seeded by the simple mean of the first
+//     14 changes,
+//   - MACD from EMA12/EMA26 seeded with the first price, with a 9-period
+//     EMA signal line seeded with the first MACD value.
+// Warm-up mirrors computeIndicators: SMAs read 0 until their window is
+// full, RSI reads 50 until 14 changes are seen, MACD reads 0 until 26 bars.
+class IncrementalIndicator {
+public:
+    static constexpr int kShortPeriod = 20;
+    static constexpr int kLongPeriod = 50;
+    static constexpr int kRsiPeriod = 14;
+    static constexpr int kFastPeriod = 12;
+    static constexpr int kSlowPeriod = 26;
+    static constexpr int kSignalPeriod = 9;
+
+    explicit IncrementalIndicator(const std::string& symbol = "");
+    // For callers that already hold the symbol's ID; skips the symbol table.
+    IncrementalIndicator(const std::string& symbol, SymbolTable::Id symbolId);
+
+    void push(double price);
+    TechnicalIndicator::IndicatorResult update(double price);
+    TechnicalIndicator::IndicatorResult result() const;
+    void reset();
+
+    const std::string& symbol() const { return symbol_; }
+    size_t count() const { return count_; }
+    double sma20() const;
+    double sma50() const;
+    double rsi() const;
+    double macd() const;
+    double macdSignal() const;
+
+private:
+    std::string symbol_;
+    SymbolTable::Id symbolId_;
+    std::array<double, kLongPeriod> window_;
+    size_t head_;
+    size_t count_;
+
+    double sum20_;
+    double sum50_;
+
+    double lastPrice_;
+    double avgGain_;
+    double avgLoss_;
+
+    double ema12_;
+    double ema26_;
+    double signalEma_;
+};
+
+#endif
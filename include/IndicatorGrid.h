@@ -0,0 +1,97 @@
+#ifndef INDICATOR_GRID_H
+#define INDICATOR_GRID_H
+
+#include "TechnicalIndicator.h"
+#include <cstddef>
+#include <vector>
+
+// Evaluates many indicator parameterizations per symbol in one pass over
+// each price series, for strategy sweeps that would otherwise call
+// computeIndicators once per combination.
+//
+//   - Every SMA period is a difference of one shared prefix-sum array.
+//   - Every RSI period and every distinct EMA period of the MACD specs
+//     advance together in a single loop over the prices, sharing the
+//     per-bar gain/loss and price loads.
+//
+// Values are those of the last bar under the full-history recurrences of
+// computeIndicatorSeries (EMAs seeded with the first price, Wilder RSI
+// seeded with the mean of the first period changes, MACD signal seeded
+// with the first MACD value), so RSI{14} and MACD{12,26,9} reproduce the
+// last element of computeIndicatorSeries exactly, and SMA{20,50} up to
+// rounding (prefix differences instead of running sums). Warm-up values
+// match it too: SMA 0, RSI 50, MACD and signal 0.
+//
+// Work is parallel over (symbol x parameter block): the recurrences are
+// split into blocks of at most kBlockSize RSI periods and kBlockSize MACD
+// specs, so a few long symbols with a large grid still spread over all
+// threads.
+class IndicatorGrid {
+public:
+    static constexpr size_t kBlockSize = 16;
+
+    struct MacdParams {
+        int fast;
+        int slow;
+        int signal;
+    };
+
+    struct Spec {
+        std::vector<int> smaPeriods;
+        std::vector<int> rsiPeriods;
+        std::vector<MacdParams> macdParams;
+    };
+
+    // Row-major: row s holds symbol s, column j parameter j of the spec.
+    struct Result {
+        size_t symbols = 0;
+        size_t smaCount = 0;
+        size_t rsiCount = 0;
+        size_t macdCount = 0;
+        std::vector<double> sma;
+        std::vector<double> rsi;
+        std::vector<double> macd;
+        std::vector<double> macdSignal;
+
+        double smaAt(size_t symbol, size_t period) const { return sma[symbol * smaCount + period]; }
+        double rsiAt(size_t symbol, size_t period) const { return rsi[symbol * rsiCount + period]; }
+        double macdAt(size_t symbol, size_t spec) const { return macd[symbol * macdCount + spec]; }
+        double macdSignalAt(size_t symbol, size_t spec) const {
+            return macdSignal[symbol * macdCount + spec];
+        }
+        size_t combinations() const { return smaCount * smaCount * rsiCount * macdCount; }
+    };
+
+    // Periods must be positive; throws std::invalid_argument otherwise.
+    explicit IndicatorGrid(Spec spec);
+
+    const Spec& spec() const { return spec_; }
+
+    Result compute(const std::vector<TechnicalIndicator::StockData>& stocks) const;
+    Result compute(const std::vector<TechnicalIndicator::PriceSeriesView>& series) const;
+
+    // One combination of a computed grid as a scored result, with the
+    // short/long SMA, RSI and MACD taken from the given spec indices.
+    static TechnicalIndicator::IndicatorResult combination(
+        const Result& result, size_t symbol, SymbolTable::Id symbolId,
+        size_t shortSma, size_t longSma, size_t rsi, size_t macd);
+
+private:
+    // One parallel work item's share of the recurrences.
+    struct Block {
+        std::vector<size_t> rsi;        // indices into spec_.rsiPeriods
+        std::vector<size_t> macd;       // indices into spec_.macdParams
+        std::vector<int> emaPeriods;    // distinct EMA periods of those specs
+        std::vector<size_t> fastEma;    // per macd entry: index into emaPeriods
+        std::vector<size_t> slowEma;
+    };
+
+    void computeSma(const double* prices, size_t length, double* out) const;
+    void computeBlock(const double* prices, size_t length, const Block& block,
+                      double* rsiOut, double* macdOut, double* signalOut) const;
+
+    Spec spec_;
+    std::vector<Block> blocks_;
+};
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef INDICATOR_PIPELINE_H
+#define INDICATOR_PIPELINE_H
+
+#include "TechnicalIndicator.h"
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Compile-time composition of snapshot indicators, e.g.
+//
+//   using Desk = IndicatorPipeline<SMA<20>, RSI<14>>;
+//   auto results = indicator.computeIndicatorsParallel<Desk>(stocks);
+//   double rsi = results[0].get<RSI<14>>();
+//
+// Each stage declares its look-back window as a constant, so the pipeline
+// walks the trailing max(window) bars in a single loop whose trip count and
+// per-stage start offsets are known at compile time, and the result holds
+// only the selected stages' values. SMA and RSI stages follow the
+// computeIndicators snapshot definitions, so SMA<20>, SMA<50> and RSI<14>
+// reproduce its fields exactly; MACD carries a real signal EMA instead of
+// calculateMACD's 0.9 * MACD approximation (see below).
+//
+// A stage provides kLookback, a Value type and a default-constructible
+// State with step(prices, t), called for each of the last kLookback bars in
+// order, and finish(length), which also covers series shorter than the
+// window.
+
+template<int Period>
+struct SMA {
+    static_assert(Period > 0, "SMA period must be positive");
+    static constexpr size_t kLookback = Period;
+    using Value = double;
+
+    struct State {
+        double sum = 0.0;
+        void step(const double* prices, size_t t) { sum += prices[t]; }
+        Value finish(size_t length) const { return length >= kLookback ? sum / Period : 0.0; }
+    };
+};
+
+// Mean gain over mean loss of the changes inside the window, as in
+// calculateRSI; 50 until Period + 1 bars are available.
+template<int Period>
+struct RSI {
+    static_assert(Period > 1, "RSI period must be at least 2");
+    static constexpr size_t kLookback = Period;
+    using Value = double;
+
+    struct State {
+        double gain = 0.0;
+        double loss = 0.0;
+        bool started = false;
+        void step(const double* prices, size_t t) {
+            if (started) {
+                double change = prices[t] - prices[t - 1];
+                if (change > 0) gain += change;
+                else loss -= change;
+            }
+            started = true;
+        }
+        Value finish(size_t length) const {
+            if (length < kLookback + 1) {
+                return 50.0;
+            }
+            double avgGain = gain / Period;
+            double avgLoss = loss / Period;
+            if (avgLoss == 0.0) {
+                return 100.0;
+            }
+            return 100.0 - (100.0 / (1.0 + avgGain / avgLoss));
+        }
+    };
+};
+
+// MACD line and its Signal-bar EMA over the trailing Slow + Signal - 1
+// bars, with the recurrences of computeIndicatorSeries: both price EMAs are
+// seeded with the window's first price and the signal EMA with the first
+// MACD value, Slow - 1 bars in. The values are the last element of
+// computeIndicatorSeries run over that window (the whole series when it is
+// shorter); 0 until Slow bars exist.
+template<int Fast, int Slow, int Signal>
+struct MACD {
+    static_assert(Fast > 0 && Fast < Slow && Signal > 0, "MACD needs 0 < Fast < Slow, Signal > 0");
+    static constexpr size_t kLookback = Slow + Signal - 1;
+    struct Value {
+        double macd;
+        double signal;
+    };
+
+    struct State {
+        double fast = 0.0;
+        double slow = 0.0;
+        double macd = 0.0;
+        double signal = 0.0;
+        size_t index = 0;
+        void step(const double* prices, size_t t) {
+            constexpr double kFastMultiplier = 2.0 / (Fast + 1);
+            constexpr double kSlowMultiplier = 2.0 / (Slow + 1);
+            constexpr double kSignalMultiplier = 2.0 / (Signal + 1);
+            double price = prices[t];
+            if (index == 0) {
+                fast = price;
+                slow = price;
+            } else {
+                fast = (price - fast) * kFastMultiplier + fast;
+                slow = (price - slow) * kSlowMultiplier + slow;
+            }
+            if (index + 1 >= static_cast<size_t>(Slow)) {
+                macd = fast - slow;
+                signal = index + 1 == static_cast<size_t>(Slow)
+                    ? macd : (macd - signal) * kSignalMultiplier + signal;
+            }
+            ++index;
+        }
+        Value finish(size_t) const { return {macd, signal}; }
+    };
+};
+
+template<typename... Stages>
+class IndicatorPipeline {
+    static_assert(sizeof...(Stages) > 0, "IndicatorPipeline needs at least one stage");
+
+    template<typename Stage, size_t I, typename... Rest>
+    struct IndexOf;
+    template<typename Stage, size_t I, typename First, typename... Rest>
+    struct IndexOf<Stage, I, First, Rest...>
+        : std::conditional_t<std::is_same<Stage, First>::value,
+                             std::integral_constant<size_t, I>, IndexOf<Stage, I + 1, Rest...>> {};
+    template<typename Stage, size_t I>
+    struct IndexOf<Stage, I> {
+        static_assert(I != I, "stage is not part of this pipeline");
+    };
+
+public:
+    static constexpr size_t kLookback = std::max({Stages::kLookback...});
+
+    struct Result {
+        SymbolTable::Id symbolId;
+        std::tuple<typename Stages::Value...> values;
+
+        template<typename Stage>
+        const typename Stage::Value& get() const {
+            return std::get<IndexOf<Stage, 0, Stages...>::value>(values);
+        }
+    };
+
+    static Result compute(const TechnicalIndicator::PriceSeriesView& series) {
+        return compute(series, std::index_sequence_for<Stages...>{});
+    }
+
+    static Result compute(const TechnicalIndicator::StockData& stock) {
+        return compute(TechnicalIndicator::makeView(stock));
+    }
+
+private:
+    template<size_t... I>
+    static Result compute(const TechnicalIndicator::PriceSeriesView& series,
+                          std::index_sequence<I...>) {
+        std::tuple<typename Stages::State...> states;
+        const double* prices = series.prices;
+        const size_t length = series.length;
+        const SymbolTable::Id id = TechnicalIndicator::resolveSymbolId(series);
+
+        if (length == 0) {
+            return Result{id, {}};  // zeroed, as computeIndicators reports it
+        }
+        if (length >= kLookback) {
+            // Fixed trip count; stage I joins at the compile-time offset
+            // kLookback - Stage::kLookback.
+            const double* window = prices + (length - kLookback);
+            for (size_t k = 0; k < kLookback; ++k) {
+                ((k >= kLookback - Stages::kLookback ? std::get<I>(states).step(window, k)
+                                                     : void()), ...);
+            }
+        } else {
+            // Short series: every stage sees what there is and reports its
+            // warm-up value from finish().
+            for (size_t t = 0; t < length; ++t) {
+                ((t + Stages::kLookback >= length ? std::get<I>(states).step(prices, t)
+                                                  : void()), ...);
+            }
+        }
+
+        return Result{id, std::make_tuple(std::get<I>(states).finish(length)...)};
+    }
+};
+
+template<typename Pipeline>
+std::vector<typename Pipeline::Result> TechnicalIndicator::computeIndicatorsParallel(
+    const std::vector<StockData>& stocks) {
+
+    std::vector<typename Pipeline::Result> results(stocks.size());
+    const long count = static_cast<long>(stocks.size());
+
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < count; ++i) {
+        results[i] = Pipeline::compute(stocks[i]);
+    }
+
+    return results;
+}
+
+template<typename Pipeline>
+std::vector<typename Pipeline::Result> TechnicalIndicator::computeIndicatorsParallel(
+    const std::vector<PriceSeriesView>& series) {
+
+    std::vector<typename Pipeline::Result> results(series.size());
+    const long count = static_cast<long>(series.size());
+
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < count; ++i) {
+        results[i] = Pipeline::compute(series[i]);
+    }
+
+    return results;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// HDR-style log-linear histogram of non-negative integer samples (usually
+// nanoseconds). Values below 32 get exact buckets; above that each power
+// of two is split into 16 linear sub-buckets, bounding the relative error
+// of any reported quantile to about 3% over the full 64-bit range.
+//
+// record() is a handful of relaxed atomic adds, meant to be called by the
+// one thread that owns the histogram; any thread may take a snapshot() at
+// any time and merge snapshots from several owners.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kHalfSubBuckets = kSubBuckets / 2;
+    static constexpr size_t kBuckets = kSubBuckets + (64 - kSubBucketBits) * kHalfSubBuckets;
+
+    struct Snapshot {
+        std::array<uint64_t, kBuckets> counts{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+
+        void merge(const Snapshot& other);
+        // q in [0, 1]; returns the midpoint of the bucket holding the
+        // q-quantile, clamped to the recorded maximum. 0 when empty.
+        uint64_t quantile(double q) const;
+        double mean() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+    };
+
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void record(std::chrono::nanoseconds elapsed) {
+        record(static_cast<uint64_t>(elapsed.count() > 0 ? elapsed.count() : 0));
+    }
+    Snapshot snapshot() const;
+    void reset();
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketLowerBound(size_t index);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> counts_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef NUMA_INDICATOR_ENGINE_H
+#define NUMA_INDICATOR_ENGINE_H
+
+#include "ColumnarPriceStore.h"
+#include "NumaTopology.h"
+#include "TechnicalIndicator.h"
+#include <cstddef>
+#include <vector>
+
+// NUMA-aware variant of computeIndicatorsParallel for a universe that is
+// loaded once and analyzed repeatedly.
+//
+// load() splits the symbols into one contiguous partition per node, sized
+// by price count in proportion to the node's CPUs. A thread pinned to that
+// node builds the partition's price arena and result buffer, so the pages
+// are first touched, and therefore placed, on the node that will read
+// them. compute() runs every node's partition on an OpenMP team inherited
+// from its pinned thread, so workers never leave their node and never read
+// prices across the interconnect.
+//
+// On a single-node machine there is nothing to place: everything runs on
+// the caller's threads without pinning, the same as the plain parallel path.
+class NumaIndicatorEngine {
+public:
+    struct NodeStats {
+        int node = 0;
+        size_t cpus = 0;
+        bool pinned = false;     // false when affinity could not be set
+        size_t symbols = 0;
+        size_t bars = 0;
+        double seconds = 0.0;    // wall time of this node's last compute()
+        double symbolsPerSecond() const { return seconds > 0 ? symbols / seconds : 0.0; }
+        double barsPerSecond() const { return seconds > 0 ? bars / seconds : 0.0; }
+    };
+
+    explicit NumaIndicatorEngine(NumaTopology topology = NumaTopology::detect());
+
+    void load(const std::vector<TechnicalIndicator::StockData>& stocks);
+    // Results in load() order; identical to computeIndicatorsParallel.
+    std::vector<TechnicalIndicator::IndicatorResult> compute();
+
+    const NumaTopology& topology() const { return topology_; }
+    size_t size() const { return size_; }
+    const std::vector<NodeStats>& nodeStats() const { return stats_; }
+
+private:
+    struct Partition {
+        size_t first = 0;  // index of the partition's first symbol in load() order
+        ColumnarPriceStore store;
+        std::vector<TechnicalIndicator::IndicatorResult> results;
+    };
+
+    template<typename Body>
+    void runOnNodes(Body body);
+
+    NumaTopology topology_;
+    TechnicalIndicator indicator_;
+    std::vector<Partition> partitions_;
+    std::vector<NodeStats> stats_;
+    size_t size_ = 0;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef NUMA_TOPOLOGY_H
+#define NUMA_TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// NUMA nodes and the CPUs attached to each, read from sysfs
+// (/sys/devices/system/node/node<N>/cpulist). Machines without that tree,
+// or with one node, come back as a single node holding every CPU the
+// process may run on, so callers never need a special case.
+class NumaTopology {
+public:
+    static constexpr const char* kSysfsNodeRoot = "/sys/devices/system/node";
+
+    struct Node {
+        int id;
+        std::vector<int> cpus;
+    };
+
+    // Nodes from sysfs restricted to the process affinity mask.
+    static NumaTopology detect();
+    // Raw sysfs contents under root; empty when root cannot be read or a
+    // node's cpulist is malformed.
+    static NumaTopology fromSysfs(const std::string& root);
+    static NumaTopology singleNode(std::vector<int> cpus);
+    static NumaTopology fromNodes(std::vector<Node> nodes);
+
+    // Parses the kernel's list format, e.g. "0-3,8,10-11". Throws
+    // std::invalid_argument on malformed input and std::out_of_range on a
+    // CPU number that does not fit an int.
+    static std::vector<int> parseCpuList(const std::string& list);
+    // CPUs in this process's affinity mask (all hardware threads when the
+    // mask cannot be read).
+    static std::vector<int> allowedCpus();
+    // Binds the calling thread to the given CPUs; false when unsupported
+    // or rejected by the kernel.
+    static bool pinCurrentThread(const std::vector<int>& cpus);
+
+    // Drops CPUs outside allowed and nodes left without CPUs; falls back to
+    // a single node of allowed when nothing remains.
+    NumaTopology restrictedTo(const std::vector<int>& allowed) const;
+
+    const std::vector<Node>& nodes() const { return nodes_; }
+    size_t size() const { return nodes_.size(); }
+    size_t cpuCount() const;
+    bool isMultiNode() const { return nodes_.size() > 1; }
+
+private:
+    std::vector<Node> nodes_;
+};
+
+#endif
@@ -10,7 +10,8 @@ public:
     static void plotEfficiency(double efficiency, int numThreads);
     static void plotExecutionTime(double sequentialTime, double parallelTime);
     static void plotScalability(const std::vector<int>& stockCounts, 
-                                const std::vector<double>& speedups);
+                                const std::vector<double>& speedups,
+                                const std::string& label = "Stocks");
     static void generateReport(double sequentialTime, double parallelTime,
                               double speedup, double efficiency, int numThreads);
     static void generateAnalysis(double speedup, double efficiency, int numThreads, int numStocks);
@@ -0,0 +1,331 @@
+#ifndef PRECISION_INDICATORS_H
+#define PRECISION_INDICATORS_H
+
+#include "ColumnarPriceStore.h"
+#include "TechnicalIndicator.h"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Storage and arithmetic precision for the indicator kernels. Storage is
+// the type prices (and series outputs) are kept in; Accumulator is the type
+// every sum, average and EMA recurrence is carried in.
+template<typename Storage, typename Accumulator>
+struct Precision {
+    static_assert(std::is_floating_point<Storage>::value &&
+                  std::is_floating_point<Accumulator>::value,
+                  "precisions must be floating-point types");
+    static_assert(sizeof(Accumulator) >= sizeof(Storage),
+                  "accumulating below storage precision discards data");
+    using StorageType = Storage;
+    using AccumulatorType = Accumulator;
+};
+
+// The reference path; TechnicalIndicator's double kernels are this
+// instantiation.
+using DoublePrecision = Precision<double, double>;
+// Half the memory, with double accumulation so the long running sums and
+// EMA recurrences do not pick up float rounding.
+using MixedPrecision = Precision<float, double>;
+// Half the memory and twice the SIMD lanes, at float accuracy.
+using SinglePrecision = Precision<float, float>;
+
+// SMA20/SMA50/RSI14/MACD kernels templated on precision, with the same
+// definitions as TechnicalIndicator: snapshots of the last bar, the fused
+// full-series sweep, and a batch scan over a BasicColumnarPriceStore.
+template<typename P>
+class PrecisionIndicators {
+public:
+    using Storage = typename P::StorageType;
+    using Accumulator = typename P::AccumulatorType;
+
+    // Symbols advanced together in the batch scan: one cache line of
+    // accumulators, so float lanes are twice as many as double lanes.
+    static constexpr size_t kLanes = kCacheLineSize / sizeof(Accumulator);
+    static constexpr size_t kWindow = SimdKernels::kWindow;
+
+    // Output buffers for computeSeries, one element per price; fields are
+    // named as in TechnicalIndicator::IndicatorSeries.
+    struct Series {
+        Storage* sma_20;
+        Storage* sma_50;
+        Storage* rsi;
+        Storage* macd;
+        Storage* macd_signal;
+    };
+
+    static Accumulator sma(const Storage* prices, size_t length, int period) {
+        if (length < static_cast<size_t>(period)) {
+            return 0;
+        }
+        Accumulator sum = 0;
+        for (size_t i = length - period; i < length; ++i) {
+            sum += prices[i];
+        }
+        return sum / period;
+    }
+
+    static Accumulator rsi(const Storage* prices, size_t length, int period = 14) {
+        if (length < static_cast<size_t>(period + 1)) {
+            return 50;
+        }
+        Accumulator gains = 0, losses = 0;
+        for (size_t i = length - period; i < length - 1; ++i) {
+            Accumulator change = Accumulator(prices[i + 1]) - Accumulator(prices[i]);
+            if (change > 0) {
+                gains += change;
+            } else {
+                losses -= change;
+            }
+        }
+        Accumulator avgGain = gains / period;
+        Accumulator avgLoss = losses / period;
+        if (avgLoss == 0) {
+            return 100;
+        }
+        return 100 - (100 / (1 + avgGain / avgLoss));
+    }
+
+    static std::pair<Accumulator, Accumulator> macd(const Storage* prices, size_t length) {
+        if (length < 26) {
+            return {0, 0};
+        }
+        const Accumulator multiplier12 = Accumulator(2.0 / (12 + 1));
+        const Accumulator multiplier26 = Accumulator(2.0 / (26 + 1));
+        Accumulator ema12 = prices[length - 12];
+        Accumulator ema26 = prices[length - 26];
+        for (size_t i = length - 12 + 1; i < length; ++i) {
+            ema12 = (prices[i] - ema12) * multiplier12 + ema12;
+        }
+        for (size_t i = length - 26 + 1; i < length; ++i) {
+            ema26 = (prices[i] - ema26) * multiplier26 + ema26;
+        }
+        Accumulator value = ema12 - ema26;
+        return {value, value * Accumulator(0.9)};
+    }
+
+    static TechnicalIndicator::IndicatorResult compute(SymbolTable::Id symbolId,
+                                                       const Storage* prices, size_t length) {
+        TechnicalIndicator::IndicatorResult result{};
+        result.symbolId = symbolId;
+        if (length == 0) {
+            result.signal = TechnicalIndicator::Signal::Hold;
+            return result;
+        }
+        auto macdPair = macd(prices, length);
+        finish(result, sma(prices, length, 20), sma(prices, length, 50),
+               rsi(prices, length, 14), macdPair.first, macdPair.second);
+        return result;
+    }
+
+    // Snapshot of every symbol in the store, in store order. Series with a
+    // full window are advanced kLanes at a time from a transposed tile of
+    // their last kWindow prices, which the compiler vectorizes across
+    // symbols; the rest run the scalar kernels. Results equal compute().
+    static std::vector<TechnicalIndicator::IndicatorResult> computeParallel(
+        const BasicColumnarPriceStore<Storage>& store) {
+
+        std::vector<TechnicalIndicator::IndicatorResult> results(store.size());
+        const long groups = static_cast<long>((store.size() + kLanes - 1) / kLanes);
+
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+        #endif
+        for (long g = 0; g < groups; ++g) {
+            size_t begin = static_cast<size_t>(g) * kLanes;
+            size_t end = std::min(begin + kLanes, store.size());
+            bool full = end - begin == kLanes;
+            for (size_t i = begin; full && i < end; ++i) {
+                full = store.length(i) >= kWindow;
+            }
+            if (full) {
+                computeLanes(store, begin, results.data() + begin);
+            } else {
+                for (size_t i = begin; i < end; ++i) {
+                    results[i] = compute(store.symbolId(i), store.prices(i), store.length(i));
+                }
+            }
+        }
+        return results;
+    }
+
+    // Every bar's values, as TechnicalIndicator::computeIndicatorSeries.
+    // Output is any struct of sma_20/sma_50/rsi/macd/macd_signal pointers.
+    template<typename Output>
+    static void computeSeries(const Storage* prices, size_t length, const Output& out) {
+        const Accumulator multiplier12 = Accumulator(2.0 / (12 + 1));
+        const Accumulator multiplier26 = Accumulator(2.0 / (26 + 1));
+        const Accumulator multiplier9 = Accumulator(2.0 / (9 + 1));
+
+        // One fused sweep: the SMA windows are running sums (add the new
+        // price, drop the oldest), RSI and the EMAs are carried recurrences,
+        // so every bar costs O(1). The running sums are re-summed from their
+        // windows every kLongPeriod bars, as IncrementalIndicator does, so
+        // rounding cannot accumulate over a long history at any precision.
+        constexpr size_t kLongPeriod = 50;
+        Accumulator sum20 = 0, sum50 = 0;
+        Accumulator avgGain = 0, avgLoss = 0;
+        Accumulator ema12 = 0, ema26 = 0, signal = 0;
+
+        for (size_t t = 0; t < length; ++t) {
+            Accumulator price = prices[t];
+
+            sum20 += price;
+            sum50 += price;
+            if (t >= 20) sum20 -= prices[t - 20];
+            if (t >= 50) sum50 -= prices[t - 50];
+            if ((t + 1) % kLongPeriod == 0) {
+                sum20 = 0;
+                sum50 = 0;
+                for (size_t i = t + 1 - kLongPeriod; i <= t; ++i) {
+                    sum50 += prices[i];
+                    if (i + 20 > t) sum20 += prices[i];
+                }
+            }
+            out.sma_20[t] = (t + 1 >= 20) ? sum20 / 20 : 0;
+            out.sma_50[t] = (t + 1 >= 50) ? sum50 / 50 : 0;
+
+            if (t == 0) {
+                ema12 = price;
+                ema26 = price;
+            } else {
+                Accumulator change = price - prices[t - 1];
+                Accumulator gain = change > 0 ? change : 0;
+                Accumulator loss = change > 0 ? 0 : -change;
+                if (t < 14) {
+                    avgGain += gain;
+                    avgLoss += loss;
+                } else if (t == 14) {
+                    avgGain = (avgGain + gain) / 14;
+                    avgLoss = (avgLoss + loss) / 14;
+                } else {
+                    avgGain = (avgGain * 13 + gain) / 14;
+                    avgLoss = (avgLoss * 13 + loss) / 14;
+                }
+
+                ema12 = (price - ema12) * multiplier12 + ema12;
+                ema26 = (price - ema26) * multiplier26 + ema26;
+            }
+
+            if (t < 14) {
+                out.rsi[t] = 50;
+            } else if (avgLoss == 0) {
+                out.rsi[t] = 100;
+            } else {
+                out.rsi[t] = 100 - (100 / (1 + avgGain / avgLoss));
+            }
+
+            if (t + 1 < 26) {
+                out.macd[t] = 0;
+                out.macd_signal[t] = 0;
+                continue;
+            }
+            Accumulator value = ema12 - ema26;
+            signal = (t + 1 == 26) ? value : (value - signal) * multiplier9 + signal;
+            out.macd[t] = value;
+            out.macd_signal[t] = signal;
+        }
+    }
+
+private:
+    static void finish(TechnicalIndicator::IndicatorResult& result, double sma20, double sma50,
+                       double rsiValue, double macdValue, double macdSignal) {
+        result.sma_20 = sma20;
+        result.sma_50 = sma50;
+        result.rsi = rsiValue;
+        result.macd = macdValue;
+        result.macd_signal = macdSignal;
+        result.signal = TechnicalIndicator::classifySignal(sma20, sma50, rsiValue, macdValue,
+                                                           macdSignal);
+        result.signal_strength = TechnicalIndicator::calculateSignalStrength(
+            sma20, sma50, rsiValue, macdValue, macdSignal);
+    }
+
+    // kLanes symbols starting at first, each with at least kWindow prices.
+    // The per-lane arithmetic is that of the scalar kernels, in the same
+    // order, so each lane matches compute() exactly.
+    static void computeLanes(const BasicColumnarPriceStore<Storage>& store, size_t first,
+                             TechnicalIndicator::IndicatorResult* out) {
+        constexpr size_t kSma20Start = kWindow - 20;
+        constexpr size_t kRsiStart = kWindow - 14 + 1;
+        constexpr size_t kEma26Seed = kWindow - 26;
+        constexpr size_t kEma12Seed = kWindow - 12;
+        const Accumulator multiplier12 = Accumulator(2.0 / (12 + 1));
+        const Accumulator multiplier26 = Accumulator(2.0 / (26 + 1));
+
+        alignas(kCacheLineSize) Accumulator tile[kWindow][kLanes];
+        for (size_t j = 0; j < kLanes; ++j) {
+            const Storage* window = store.prices(first + j) + store.length(first + j) - kWindow;
+            for (size_t k = 0; k < kWindow; ++k) {
+                tile[k][j] = window[k];
+            }
+        }
+
+        // One pass per indicator over its own part of the window, so each
+        // inner loop is a branch-free update of all lanes
+        alignas(kCacheLineSize) Accumulator sum20[kLanes] = {}, sum50[kLanes] = {};
+        alignas(kCacheLineSize) Accumulator gains[kLanes] = {}, losses[kLanes] = {};
+        alignas(kCacheLineSize) Accumulator ema12[kLanes], ema26[kLanes];
+        for (size_t k = 0; k < kWindow; ++k) {
+            #ifdef _OPENMP
+            #pragma omp simd
+            #endif
+            for (size_t j = 0; j < kLanes; ++j) {
+                sum50[j] += tile[k][j];
+            }
+        }
+        for (size_t k = kSma20Start; k < kWindow; ++k) {
+            #ifdef _OPENMP
+            #pragma omp simd
+            #endif
+            for (size_t j = 0; j < kLanes; ++j) {
+                sum20[j] += tile[k][j];
+            }
+        }
+        for (size_t k = kRsiStart; k < kWindow; ++k) {
+            #ifdef _OPENMP
+            #pragma omp simd
+            #endif
+            for (size_t j = 0; j < kLanes; ++j) {
+                Accumulator change = tile[k][j] - tile[k - 1][j];
+                gains[j] += std::max(change, Accumulator(0));
+                losses[j] += std::max(-change, Accumulator(0));
+            }
+        }
+        std::copy(tile[kEma26Seed], tile[kEma26Seed] + kLanes, ema26);
+        for (size_t k = kEma26Seed + 1; k < kWindow; ++k) {
+            #ifdef _OPENMP
+            #pragma omp simd
+            #endif
+            for (size_t j = 0; j < kLanes; ++j) {
+                ema26[j] = (tile[k][j] - ema26[j]) * multiplier26 + ema26[j];
+            }
+        }
+        std::copy(tile[kEma12Seed], tile[kEma12Seed] + kLanes, ema12);
+        for (size_t k = kEma12Seed + 1; k < kWindow; ++k) {
+            #ifdef _OPENMP
+            #pragma omp simd
+            #endif
+            for (size_t j = 0; j < kLanes; ++j) {
+                ema12[j] = (tile[k][j] - ema12[j]) * multiplier12 + ema12[j];
+            }
+        }
+
+        for (size_t j = 0; j < kLanes; ++j) {
+            Accumulator avgGain = gains[j] / 14;
+            Accumulator avgLoss = losses[j] / 14;
+            Accumulator rsiValue = avgLoss == 0 ? Accumulator(100)
+                                                : 100 - (100 / (1 + avgGain / avgLoss));
+            Accumulator macdValue = ema12[j] - ema26[j];
+            TechnicalIndicator::IndicatorResult& result = out[j];
+            result = TechnicalIndicator::IndicatorResult{};
+            result.symbolId = store.symbolId(first + j);
+            finish(result, sum20[j] / 20, sum50[j] / 50, rsiValue, macdValue,
+                   macdValue * Accumulator(0.9));
+        }
+    }
+};
+
+#endif
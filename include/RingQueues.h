@@ -0,0 +1,359 @@
+#ifndef RING_QUEUES_H
+#define RING_QUEUES_H
+
+#include "AlignedAllocator.h"
+#include "ConcurrentQueue.h"
+#include "EventCount.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// Bounded lock-free ring queues. Capacity is rounded up to a power of two so
+// slot lookup is a mask, and the producer and consumer indices live on
+// separate cache lines. Blocking is done through EventCount, so an idle
+// consumer sleeps in the kernel instead of polling, and a busy one never
+// makes a syscall.
+//
+// RingQueueBase implements the blocking half of ConcurrentQueue on top of
+// the derived queue's non-blocking tryPushBulk()/tryEmplace()/tryPopBulk();
+// tryPushBulk() takes any random-access iterator so pushBulkMove() can pass
+// move iterators.
+template<typename T, typename Derived>
+class RingQueueBase : public ConcurrentQueue<T> {
+public:
+    void push(const T& item) override { blockingEmplace(item); }
+    void push(T&& item) override { blockingEmplace(std::move(item)); }
+
+    size_t pushBulk(const T* items, size_t count) override {
+        return blockingPushBulk(items, count);
+    }
+
+    size_t pushBulkMove(T* items, size_t count) override {
+        return blockingPushBulk(std::make_move_iterator(items), count);
+    }
+
+    std::optional<T> tryPop() override {
+        T item;
+        if (derived().tryPopBulk(&item, 1) == 0) {
+            return std::nullopt;
+        }
+        return item;
+    }
+
+    size_t popBulk(T* out, size_t maxItems) override {
+        return derived().tryPopBulk(out, maxItems);
+    }
+
+    size_t waitPopBulk(T* out, size_t maxItems, std::chrono::nanoseconds timeout) override {
+        if (maxItems == 0) {
+            return 0;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            size_t n = derived().tryPopBulk(out, maxItems);
+            if (n > 0) {
+                return n;
+            }
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero() ||
+                !waitFor(notEmpty_, [this] { return !derived().empty(); }, remaining)) {
+                return derived().tryPopBulk(out, maxItems);
+            }
+        }
+    }
+
+    bool empty() const override { return this->size() == 0; }
+
+    void stop() override {
+        stopped_.store(true, std::memory_order_seq_cst);
+        notEmpty_.notifyAll();
+        notFull_.notifyAll();
+    }
+
+    void reset() override {
+        stopped_.store(false, std::memory_order_seq_cst);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+protected:
+    static constexpr std::chrono::nanoseconds kBlockSlice = std::chrono::milliseconds(100);
+
+    explicit RingQueueBase(size_t requestedCapacity)
+        : capacity_(roundUpToPowerOfTwo(requestedCapacity)), mask_(capacity_ - 1) {
+    }
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = 2;
+        while (capacity < value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    // Sleeps until ready() holds or the queue stops. Returns false only when
+    // stopped; a timeout returns true so callers simply retry.
+    template<typename Predicate>
+    bool waitFor(EventCount& event, Predicate ready, std::chrono::nanoseconds timeout) {
+        uint32_t key = event.prepareWait();
+        if (stopped_.load(std::memory_order_seq_cst)) {
+            event.cancelWait();
+            return false;
+        }
+        if (ready()) {
+            event.cancelWait();
+            return true;
+        }
+        event.wait(key, timeout);
+        return !stopped_.load(std::memory_order_acquire);
+    }
+
+    template<typename U>
+    void blockingEmplace(U&& item) {
+        while (!derived().tryEmplace(std::forward<U>(item))) {
+            if (!waitFor(notFull_, [this] { return !derived().full(); }, kBlockSlice)) {
+                return;
+            }
+        }
+    }
+
+    // Items is a T pointer or a move iterator over one.
+    template<typename Iterator>
+    size_t blockingPushBulk(Iterator items, size_t count) {
+        size_t pushed = 0;
+        while (pushed < count) {
+            size_t n = derived().tryPushBulk(items + pushed, count - pushed);
+            if (n > 0) {
+                pushed += n;
+                continue;
+            }
+            if (!waitFor(notFull_, [this] { return !derived().full(); }, kBlockSlice)) {
+                break;
+            }
+        }
+        return pushed;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::atomic<bool> stopped_{false};
+    EventCount notEmpty_;
+    EventCount notFull_;
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
+// Single-producer/single-consumer ring. Exactly one thread may push and one
+// thread may pop at any time. Each side caches the other side's index and
+// only re-reads it when the cached value says the ring is full/empty.
+template<typename T>
+class SpscRingQueue final : public RingQueueBase<T, SpscRingQueue<T>> {
+    using Base = RingQueueBase<T, SpscRingQueue<T>>;
+    friend Base;
+
+public:
+    explicit SpscRingQueue(size_t capacity = 1024)
+        : Base(capacity), slots_(new T[Base::capacity_]) {
+    }
+
+    SpscRingQueue(const SpscRingQueue&) = delete;
+    SpscRingQueue& operator=(const SpscRingQueue&) = delete;
+
+    size_t size() const override {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    template<typename U>
+    bool tryEmplace(U&& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Base::capacity_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Base::capacity_) {
+                return false;
+            }
+        }
+        slots_[tail & Base::mask_] = std::forward<U>(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        Base::notEmpty_.notifyAll();
+        return true;
+    }
+
+    template<typename Iterator>
+    size_t tryPushBulk(Iterator items, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t space = Base::capacity_ - (tail - cachedHead_);
+        if (space < count) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            space = Base::capacity_ - (tail - cachedHead_);
+        }
+        size_t n = std::min(count, space);
+        if (n == 0) {
+            return 0;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            slots_[(tail + i) & Base::mask_] = items[i];
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        Base::notEmpty_.notifyAll();
+        return n;
+    }
+
+    size_t tryPopBulk(T* out, size_t maxItems) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t available = cachedTail_ - head;
+        if (available < maxItems) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            available = cachedTail_ - head;
+        }
+        size_t n = std::min(maxItems, available);
+        if (n == 0) {
+            return 0;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::move(slots_[(head + i) & Base::mask_]);
+        }
+        head_.store(head + n, std::memory_order_release);
+        Base::notFull_.notifyAll();
+        return n;
+    }
+
+private:
+    bool full() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire)
+               >= Base::capacity_;
+    }
+
+    std::unique_ptr<T[]> slots_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+};
+
+// Multi-producer/multi-consumer ring (Vyukov's bounded queue). Each slot
+// carries a sequence number that says whether it is free for position p
+// (sequence == p) or holds the item for position p (sequence == p + 1).
+// Bulk operations claim a run of ready slots with a single CAS.
+template<typename T>
+class MpmcRingQueue final : public RingQueueBase<T, MpmcRingQueue<T>> {
+    using Base = RingQueueBase<T, MpmcRingQueue<T>>;
+    friend Base;
+
+public:
+    explicit MpmcRingQueue(size_t capacity = 1024)
+        : Base(capacity), cells_(new Cell[Base::capacity_]) {
+        for (size_t i = 0; i < Base::capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingQueue(const MpmcRingQueue&) = delete;
+    MpmcRingQueue& operator=(const MpmcRingQueue&) = delete;
+
+    size_t size() const override {
+        size_t tail = enqueuePos_.load(std::memory_order_acquire);
+        size_t head = dequeuePos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    template<typename U>
+    bool tryEmplace(U&& item) {
+        size_t pos;
+        if (claimRun(enqueuePos_, 0, 1, pos) == 0) {
+            return false;
+        }
+        Cell& cell = cells_[pos & Base::mask_];
+        cell.data = std::forward<U>(item);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        Base::notEmpty_.notifyAll();
+        return true;
+    }
+
+    template<typename Iterator>
+    size_t tryPushBulk(Iterator items, size_t count) {
+        size_t pos;
+        size_t n = claimRun(enqueuePos_, 0, count, pos);
+        for (size_t i = 0; i < n; ++i) {
+            Cell& cell = cells_[(pos + i) & Base::mask_];
+            cell.data = items[i];
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        if (n > 0) {
+            Base::notEmpty_.notifyAll();
+        }
+        return n;
+    }
+
+    size_t tryPopBulk(T* out, size_t maxItems) {
+        size_t pos;
+        size_t n = claimRun(dequeuePos_, 1, maxItems, pos);
+        for (size_t i = 0; i < n; ++i) {
+            Cell& cell = cells_[(pos + i) & Base::mask_];
+            out[i] = std::move(cell.data);
+            cell.sequence.store(pos + i + Base::capacity_, std::memory_order_release);
+        }
+        if (n > 0) {
+            Base::notFull_.notifyAll();
+        }
+        return n;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    bool full() const {
+        return size() >= Base::capacity_;
+    }
+
+    // Claims up to maxCount consecutive slots whose sequence equals
+    // position + lag (lag 0: free for producers, lag 1: full for consumers).
+    size_t claimRun(std::atomic<size_t>& position, size_t lag, size_t maxCount, size_t& pos) {
+        pos = position.load(std::memory_order_relaxed);
+        if (maxCount == 0) {
+            return 0;  // a ready head cell would otherwise be retried forever
+        }
+        for (;;) {
+            size_t n = 0;
+            while (n < maxCount && n < Base::capacity_) {
+                size_t seq = cells_[(pos + n) & Base::mask_].sequence.load(
+                    std::memory_order_acquire);
+                if (seq != pos + n + lag) {
+                    break;
+                }
+                ++n;
+            }
+
+            if (n == 0) {
+                size_t seq = cells_[pos & Base::mask_].sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + lag);
+                if (diff < 0) {
+                    return 0;
+                }
+                pos = position.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (position.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                return n;
+            }
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> enqueuePos_{0};
+    alignas(kCacheLineSize) std::atomic<size_t> dequeuePos_{0};
+};
+
+#endif
@@ -2,51 +2,242 @@
 #define SCHEDULER_H
 
 #include "ThreadSafeQueue.h"
+#include "RingQueues.h"
 #include "TechnicalIndicator.h"
+#include "LatencyHistogram.h"
+#include "TimerQueue.h"
+#include "TimestampedQueue.h"
 #include <thread>
 #include <atomic>
 #include <chrono>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class WorkStealingPool;
+class StockDataFetcher;
 
 class Scheduler {
 public:
-    using AnalysisCallback = std::function<void(const std::vector<TechnicalIndicator::StockData>&)>;
+    // Called only with symbols whose series changed since they were last
+    // analyzed. Views point into an immutable cache snapshot that stays
+    // alive for the duration of the call; copy anything that must outlive it.
+    using AnalysisCallback =
+        std::function<void(const std::vector<TechnicalIndicator::PriceSeriesView>&)>;
     using NotificationCallback = std::function<void(const TechnicalIndicator::IndicatorResult&)>;
 
-    Scheduler(int intervalSeconds = 3600);
+    // Queue implementation behind dataQueue_ and the notification queue.
+    // Spsc is only valid while notifications are pushed from the analysis
+    // callback alone (its calls are serialized); use Mpmc otherwise.
+    enum class QueueKind { Locking, Spsc, Mpmc };
+
+    // Counters of the ingest stage that drains dataQueue_. Rates are
+    // measured from the last start().
+    struct StreamStats {
+        uint64_t updatesReceived = 0;
+        uint64_t batchesDrained = 0;
+        uint64_t symbolsChanged = 0;
+        size_t queueDepth = 0;
+        size_t peakQueueDepth = 0;
+        double updatesPerSecond = 0.0;
+    };
+
+    enum class MetricsFormat { Prometheus, Json };
+
+    static constexpr size_t kDefaultRetentionBars = 1024;
+    static constexpr size_t kMinRetentionBars = 50;
+
+    // One published version of the price cache. Never modified once
+    // published: writers build the next version alongside it, sharing every
+    // series (and the index) that did not change, and readers keep whichever
+    // version they loaded alive through the shared_ptr.
+    struct CacheSnapshot {
+        uint64_t version = 0;
+        std::vector<std::shared_ptr<const TechnicalIndicator::StockData>> series;
+        // Cache version in which series[i] last changed.
+        std::vector<uint64_t> versions;
+        std::shared_ptr<const std::unordered_map<std::string, size_t>> index;
+
+        const TechnicalIndicator::StockData* find(const std::string& symbol) const;
+        std::vector<TechnicalIndicator::PriceSeriesView> views() const;
+    };
+
+    Scheduler(int intervalSeconds = 3600, QueueKind queueKind = QueueKind::Locking,
+              size_t queueCapacity = 4096);
+    // Sub-second cycles, e.g. std::chrono::milliseconds(250) for intraday use.
+    explicit Scheduler(std::chrono::nanoseconds interval,
+                       QueueKind queueKind = QueueKind::Locking, size_t queueCapacity = 4096);
     ~Scheduler();
 
     void start();
     void stop();
     void setAnalysisCallback(AnalysisCallback callback);
     void setNotificationCallback(NotificationCallback callback);
+    // Upserts by symbol and timestamp; see mergeSeries(). Every call
+    // publishes its own cache version, which copies the version's series
+    // pointers (one refcount increment per symbol), so loading N symbols
+    // one call at a time is O(N^2). The batch overload publishes once.
     void addStockData(const TechnicalIndicator::StockData& stockData);
-    ThreadSafeQueue<TechnicalIndicator::IndicatorResult>& getNotificationQueue();
+    void addStockData(const std::vector<TechnicalIndicator::StockData>& stocks);
+    // Bars kept per symbol (default kDefaultRetentionBars); older bars are
+    // dropped as new ones arrive, so memory stays bounded by symbols times
+    // retention. Values below the longest snapshot window (50) are raised
+    // to it; 0 keeps full history. Applies to later updates only.
+    void setRetention(size_t bars);
+    // Period of the background fetch rounds (default 5 s). Call before start().
+    void setFetchInterval(std::chrono::nanoseconds interval) { fetchInterval_ = interval; }
+    // Independent schedule that checks just these symbols every interval and
+    // runs the analysis callback on those that changed since they were last
+    // analyzed (by any schedule). Watchlists run
+    // on the scheduler thread alongside the main cycle and survive
+    // stop()/start(). Safe to call at any time.
+    TimerQueue::TimerId addWatchlist(const std::vector<std::string>& symbols,
+                                     std::chrono::nanoseconds interval);
+    bool removeWatchlist(TimerQueue::TimerId id);
+    // Optional pool the data fetcher fans its per-symbol fetches out to.
+    // Must outlive the scheduler's running threads.
+    void setWorkerPool(WorkStealingPool* pool) { workerPool_ = pool; }
+    ConcurrentQueue<TechnicalIndicator::IndicatorResult>& getNotificationQueue();
     bool isRunning() const { return running_; }
+    StreamStats streamStats() const;
+    // Current cache version. Never waits for a writer's merge; the atomic
+    // shared_ptr load itself takes a short lock (see cache_).
+    std::shared_ptr<const CacheSnapshot> snapshot() const;
+    // Last result dispatched for each symbol. Symbols that have not changed
+    // since they were last analyzed keep their previous result here.
+    std::vector<TechnicalIndicator::IndicatorResult> latestResults() const;
+
+    // Aggregates the per-thread histograms and counters into one report.
+    // Latencies are in seconds, queue depths in items.
+    std::string metricsReport(MetricsFormat format) const;
+    // Writes metricsReport() via a temporary file and rename, so readers
+    // never see a partial dump. Returns false on I/O failure.
+    bool writeMetrics(const std::string& path, MetricsFormat format) const;
+    // Dumps metrics to path every intervalSeconds while running, and once
+    // more on stop(). Call before start(); an empty path disables it.
+    void setMetricsDump(const std::string& path, int intervalSeconds,
+                        MetricsFormat format = MetricsFormat::Prometheus);
 
 private:
     void schedulerThread();
     void dataFetcherThread();
     void notificationDispatcherThread();
+    void ingestThread();
+    void metricsThread();
+    void runAnalysisCycle();
+    void analyzeWatchlist(const std::vector<std::string>& symbols);
+    // Runs analysisCallback_ on the candidates whose version in cache is
+    // newer than the one last analyzed, and marks them analyzed. Returns
+    // the number analyzed.
+    size_t analyzeStale(const CacheSnapshot& cache, const std::vector<size_t>& candidates,
+                        LatencyHistogram& computeHistogram);
+    void fetchRound(StockDataFetcher& fetcher, const std::vector<std::string>& symbols);
+    // Merges updates into a new cache version and publishes it. Returns the
+    // published snapshot; changed (if given) receives the indices of the
+    // series that moved, sorted and unique.
+    std::shared_ptr<const CacheSnapshot> publishUpdates(
+        TechnicalIndicator::StockData* updates, size_t count, std::vector<size_t>* changed);
+    // Upserts by timestamp: bars at or after the update's first timestamp
+    // are replaced, later ones appended, and only the last retention bars
+    // are kept. Returns the merged series, or null if the update leaves
+    // cached unchanged.
+    static std::shared_ptr<const TechnicalIndicator::StockData> mergeSeries(
+        const TechnicalIndicator::StockData& cached, TechnicalIndicator::StockData&& update,
+        size_t retention);
+    static std::shared_ptr<const TechnicalIndicator::StockData> retainTail(
+        TechnicalIndicator::StockData&& stock, size_t retention);
+
+    // Every queue is wrapped in a TimestampedQueue that records each item's
+    // enqueue-to-dequeue time into waits.
+    template<typename T>
+    static std::unique_ptr<ConcurrentQueue<T>> makeQueue(QueueKind kind, size_t capacity,
+                                                         LatencyHistogram& waits);
 
-    int intervalSeconds_;
+    std::chrono::nanoseconds interval_;
+    std::chrono::nanoseconds fetchInterval_ = std::chrono::seconds(5);
     std::atomic<bool> running_;
     std::atomic<bool> shouldStop_;
 
     std::thread schedulerThread_;
     std::thread dataFetcherThread_;
     std::thread notificationDispatcherThread_;
+    std::thread ingestThread_;
+    std::thread metricsThread_;
+
+    // One event loop per timed thread; stop() wakes each immediately.
+    TimerQueue cycleTimers_;
+    TimerQueue fetchTimers_;
+    TimerQueue metricsTimers_;
 
     AnalysisCallback analysisCallback_;
     NotificationCallback notificationCallback_;
+    WorkStealingPool* workerPool_ = nullptr;
 
-    ThreadSafeQueue<TechnicalIndicator::StockData> dataQueue_;
-    ThreadSafeQueue<TechnicalIndicator::IndicatorResult> notificationQueue_;
+    std::unique_ptr<ConcurrentQueue<TechnicalIndicator::StockData>> dataQueue_;
+    std::unique_ptr<ConcurrentQueue<TechnicalIndicator::IndicatorResult>> notificationQueue_;
     
-    std::vector<TechnicalIndicator::StockData> stockDataCache_;
+    // Accessed only through std::atomic_load/std::atomic_store. These are
+    // not lock-free in libstdc++: each takes a mutex from an internal pool,
+    // held only for the pointer copy and refcount update. cacheMutex_
+    // serializes writers with each other and is never taken by readers, so
+    // a long analysis cycle cannot stall addStockData() or ingest.
+    std::shared_ptr<const CacheSnapshot> cache_;
     std::mutex cacheMutex_;
+    size_t retentionBars_ = kDefaultRetentionBars;  // guarded by cacheMutex_
+    // Indices whose series changed since the last cycle took them; written
+    // by publishUpdates(), guarded by cacheMutex_. dirtyFlags_ dedups.
+    std::vector<size_t> dirty_;
+    std::vector<char> dirtyFlags_;
+    // Serializes analysisCallback_ between the periodic cycle, watchlists
+    // and the ingest stage. Never held together with cacheMutex_.
+    std::mutex analysisMutex_;
+    // Cache version each series was last analyzed at, by whichever of the
+    // cycle, a watchlist or ingest got to it first. Guarded by analysisMutex_.
+    std::vector<uint64_t> analyzedVersions_;
+    // Reused between calls so steady-state cycles do not allocate; views
+    // guarded by analysisMutex_, the spare dirty list by the scheduler thread.
+    std::vector<TechnicalIndicator::PriceSeriesView> staleViews_;
+    std::vector<size_t> cycleDirty_;
+
+    // Written by the dispatcher only; guarded by resultsMutex_ for readers.
+    std::unordered_map<SymbolTable::Id, TechnicalIndicator::IndicatorResult> latestResults_;
+    mutable std::mutex resultsMutex_;
+
+    std::atomic<uint64_t> updatesReceived_{0};
+    std::atomic<uint64_t> batchesDrained_{0};
+    std::atomic<uint64_t> symbolsChanged_{0};
+    std::atomic<size_t> peakQueueDepth_{0};
+    std::chrono::steady_clock::time_point startTime_;
+
+    // Each histogram has a single writer thread (named in the comment), so
+    // recording never contends; readers merge snapshots on demand. The
+    // queue waits are recorded by the queues as the consumer pops.
+    struct Metrics {
+        LatencyHistogram fetch;            // fetcher: one fetch round
+        LatencyHistogram ingestWait;       // ingest: enqueue-to-dequeue time of each update
+        LatencyHistogram ingestIdle;       // ingest: idle time until updates arrive
+        LatencyHistogram cachePublish;     // ingest: merging and publishing a cache version
+        LatencyHistogram dataQueueDepth;   // ingest: depth before each drain
+        LatencyHistogram ingestCompute;    // ingest: recompute of changed symbols
+        LatencyHistogram cycleCompute;     // scheduler: periodic cycle or watchlist
+        LatencyHistogram dispatchWait;     // dispatcher: enqueue-to-dequeue time of each result
+        LatencyHistogram dispatchIdle;     // dispatcher: idle time until results arrive
+        LatencyHistogram dispatch;         // dispatcher: handling one batch
+        std::atomic<uint64_t> fetchRounds{0};
+        std::atomic<uint64_t> symbolsFetched{0};
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> notificationsDispatched{0};
+        std::atomic<uint64_t> signalsRaised{0};
+        std::atomic<uint64_t> symbolsAnalyzed{0};
+        std::atomic<uint64_t> resultsUnchanged{0};
+    };
+    Metrics metrics_;
+    std::string metricsPath_;
+    int metricsIntervalSeconds_ = 0;
+    MetricsFormat metricsFormat_ = MetricsFormat::Prometheus;
 };
 
 #endif
@@ -0,0 +1,115 @@
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include "AlignedAllocator.h"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Per-thread monotonic arena for scratch memory that lives no longer than
+// one analysis cycle or task. Allocation bumps a pointer inside a block;
+// nothing is freed individually. reset() and Scope rewind in O(1) and keep
+// the blocks, so once a thread has seen its largest working set the hot
+// path never reaches malloc and OpenMP threads never contend in it.
+//
+// Memory handed out after a mark is invalid once the arena is rewound past
+// it; scratch must not escape the Scope (or cycle) it was allocated in.
+class ScratchArena {
+public:
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    // Calling thread's arena, created on first use.
+    static ScratchArena& local();
+
+    ScratchArena() = default;
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for count objects.
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "arena memory is released without running destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    struct Marker {
+        size_t block;
+        size_t offset;
+    };
+    Marker mark() const { return {current_, offset_}; }
+    void rewind(Marker marker) {
+        current_ = marker.block;
+        offset_ = marker.offset;
+    }
+    // Releases everything, keeping the blocks for reuse.
+    void reset() { rewind({0, 0}); }
+
+    // Rewinds the arena to where it was at construction.
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena = ScratchArena::local())
+            : arena_(arena), marker_(arena.mark()) {}
+        ~Scope() { arena_.rewind(marker_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScratchArena& arena_;
+        Marker marker_;
+    };
+
+    size_t bytesUsed() const;
+    size_t capacity() const;
+    // Heap blocks requested so far; stays flat once the arena is warm.
+    size_t blockAllocations() const { return blocks_.size(); }
+
+private:
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+    size_t offset_ = 0;
+};
+
+// std allocator over an arena (the constructing thread's by default);
+// deallocate is a no-op, so reserve() up front to avoid leaving grown-out
+// buffers behind.
+template<typename T>
+class ScratchAllocator {
+public:
+    using value_type = T;
+
+    ScratchAllocator() noexcept : arena_(&ScratchArena::local()) {}
+    explicit ScratchAllocator(ScratchArena& arena) noexcept : arena_(&arena) {}
+
+    template<typename U>
+    ScratchAllocator(const ScratchAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(std::size_t n) { return arena_->allocateArray<T>(n); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    ScratchArena* arena() const noexcept { return arena_; }
+
+    template<typename U>
+    bool operator==(const ScratchAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+
+    template<typename U>
+    bool operator!=(const ScratchAllocator<U>& other) const noexcept { return arena_ != other.arena(); }
+
+private:
+    ScratchArena* arena_;
+};
+
+template<typename T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+#endif
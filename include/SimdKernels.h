@@ -0,0 +1,34 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Snapshot indicator kernels that advance several symbols in lockstep, one
+// symbol per SIMD lane. Vectorizing across symbols rather than along time is
+// what lets the EMA recurrences use the full vector width.
+class SimdKernels {
+public:
+    enum class Level { Scalar, AVX2, AVX512 };
+
+    // Number of trailing prices the snapshot indicators read (SMA50 window).
+    static constexpr int kWindow = 50;
+    static constexpr size_t kMaxLanes = 8;
+
+    static Level detectLevel();
+    static Level activeLevel();
+    static bool isSupported(Level level);
+    static size_t laneWidth(Level level);
+    static const char* levelName(Level level);
+
+    // Computes SMA20/SMA50/RSI14/MACD for laneWidth(level) series at once.
+    // Lane j reads base[windowStart[j]] .. base[windowStart[j] + kWindow - 1],
+    // i.e. the last kWindow prices of its series, and writes element j of
+    // each output array. Results match the scalar TechnicalIndicator path
+    // bit for bit. Must not be called with Level::Scalar.
+    static void snapshotLanes(Level level, const double* base, const int64_t* windowStart,
+                              double* sma20, double* sma50, double* rsi,
+                              double* macd, double* macdSignal);
+};
+
+#endif
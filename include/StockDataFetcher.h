@@ -7,6 +7,31 @@
 
 class StockDataFetcher {
 public:
+    // Zero-based column positions of a vendor CSV dump. A first line whose
+    // price field does not parse is treated as a header and skipped.
+    // Timestamps may be numeric or ISO dates (YYYY-MM-DD becomes YYYYMMDD).
+    struct CsvLayout {
+        int symbolColumn = 0;
+        int timestampColumn = 1;
+        int priceColumn = 2;
+        int volumeColumn = 3;
+        char delimiter = ',';
+    };
+
+    struct IngestStats {
+        size_t rows = 0;
+        size_t skippedRows = 0;
+        size_t symbols = 0;
+        size_t bytes = 0;
+        int threads = 1;
+        double seconds = 0.0;
+
+        double rowsPerSecond() const { return seconds > 0 ? rows / seconds : 0.0; }
+        double megabytesPerSecond() const {
+            return seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+        }
+    };
+
     StockDataFetcher();
     ~StockDataFetcher();
 
@@ -15,6 +40,18 @@ public:
         const std::vector<std::string>& symbols);
     void setTimeout(int seconds) { timeoutSeconds_ = seconds; }
 
+    // Parses a CSV file on all OpenMP threads: the mapped file is split into
+    // newline-aligned chunks, fields are parsed in place with from_chars,
+    // and rows are grouped by symbol (in first-seen order, each series
+    // sorted by timestamp). Throws std::invalid_argument if the layout has
+    // a negative or repeated column, and std::runtime_error if the file
+    // cannot be opened.
+    std::vector<TechnicalIndicator::StockData> loadCsv(const std::string& path,
+                                                       IngestStats* stats = nullptr);
+    std::vector<TechnicalIndicator::StockData> loadCsv(const std::string& path,
+                                                       const CsvLayout& layout,
+                                                       IngestStats* stats = nullptr);
+
 private:
     TechnicalIndicator::StockData generateSampleData(const std::string& symbol);
 
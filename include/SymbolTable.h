@@ -0,0 +1,37 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Interns ticker symbols into dense uint32_t IDs so per-cycle results can
+// carry a symbol without owning a string. IDs are assigned in first-seen
+// order and never reused; names stay valid for the table's lifetime.
+// Lookups of known symbols take a shared lock and do not allocate.
+class SymbolTable {
+public:
+    using Id = uint32_t;
+    static constexpr Id kInvalidId = ~Id(0);
+
+    // Process-wide table used by TechnicalIndicator and its callers.
+    static SymbolTable& global();
+
+    Id intern(std::string_view symbol);
+    // Returns kInvalidId when the symbol has not been interned.
+    Id find(std::string_view symbol) const;
+    // Returns an empty view for IDs this table never handed out.
+    std::string_view name(Id id) const;
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, Id> ids_;
+};
+
+#endif
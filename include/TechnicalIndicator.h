@@ -1,43 +1,187 @@
 #ifndef TECHNICAL_INDICATOR_H
 #define TECHNICAL_INDICATOR_H
 
+#include "AlignedAllocator.h"
+#include "SimdKernels.h"
+#include "SymbolTable.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <cstdint>
+#include <type_traits>
+
+template<typename T> class BasicColumnarPriceStore;
+using ColumnarPriceStore = BasicColumnarPriceStore<double>;
+class WorkStealingPool;
 
 class TechnicalIndicator {
 public:
+    // symbolId is assigned once at ingest (StockDataFetcher, Scheduler,
+    // MappedHistory, the price stores) so the kernels never touch the
+    // symbol table. Data built by hand can leave it unset; it is then
+    // interned on each compute, which takes the table's lock.
     struct StockData {
         std::string symbol;
         std::vector<double> prices;
         std::vector<double> volumes;
         std::vector<double> timestamps;
+        SymbolTable::Id symbolId = SymbolTable::kInvalidId;
+    };
+
+    // Non-owning view of one symbol's history, e.g. into a memory-mapped
+    // file, so it can be analyzed without copying into a StockData.
+    struct PriceSeriesView {
+        std::string_view symbol;
+        const double* prices;
+        const double* volumes;
+        const double* timestamps;
+        size_t length;
+        SymbolTable::Id symbolId = SymbolTable::kInvalidId;
     };
 
+    enum class Signal : uint8_t { Hold, Buy, Sell };
+
+    // Plain data so results can be memcpy'd through queues or written to
+    // shared memory as-is; the symbol is an ID into SymbolTable::global().
     struct IndicatorResult {
-        std::string symbol;
+        SymbolTable::Id symbolId;
+        Signal signal;
         double sma_20;
         double sma_50;
         double rsi;
         double macd;
         double macd_signal;
-        std::string signal;
         double signal_strength;
+
+        // Field-wise, so padding never makes equal results compare unequal.
+        bool operator==(const IndicatorResult& other) const {
+            return symbolId == other.symbolId && signal == other.signal &&
+                   sma_20 == other.sma_20 && sma_50 == other.sma_50 && rsi == other.rsi &&
+                   macd == other.macd && macd_signal == other.macd_signal &&
+                   signal_strength == other.signal_strength;
+        }
+        bool operator!=(const IndicatorResult& other) const { return !(*this == other); }
+    };
+
+    // Companion to IndicatorResult with the volume- and range-based set,
+    // all for the last bar. Only closes are stored, so ATR uses the
+    // close-to-close true range and the stochastic uses the highest and
+    // lowest close of its window.
+    struct ExtendedIndicators {
+        SymbolTable::Id symbolId;
+        double bollinger_middle;   // SMA 20
+        double bollinger_upper;    // middle + 2 population standard deviations
+        double bollinger_lower;
+        double atr;                // 14-bar Wilder average of |close change|
+        double stochastic_k;       // 14-bar %K
+        double stochastic_d;       // 3-bar SMA of %K, 50 until 16 bars exist
+        double obv;                // on-balance volume over the whole series
+        double vwap;               // 20-bar volume-weighted average close
+    };
+
+    // Batch output for a ColumnarPriceStore: one column per field, row i is
+    // symbol i. Columns are cache-line aligned and padded so that threads
+    // writing disjoint blocks of kColumnBlock rows never share a line.
+    struct IndicatorColumns {
+        static constexpr size_t kColumnBlock = kCacheLineSize / sizeof(Signal);
+
+        AlignedVector<double> sma_20;
+        AlignedVector<double> sma_50;
+        AlignedVector<double> rsi;
+        AlignedVector<double> macd;
+        AlignedVector<double> macd_signal;
+        AlignedVector<double> signal_strength;
+        AlignedVector<Signal> signal;
+        size_t size = 0;
+
+        void resize(size_t numSymbols);
+    };
+
+    // Caller-owned output buffers for computeIndicatorSeries, each with room
+    // for one value per input price. Element t equals what
+    // IncrementalIndicator reports after the first t + 1 prices.
+    struct IndicatorSeries {
+        double* sma_20;
+        double* sma_50;
+        double* rsi;
+        double* macd;
+        double* macd_signal;
     };
 
     TechnicalIndicator();
     ~TechnicalIndicator();
 
     IndicatorResult computeIndicators(const StockData& stockData);
+    IndicatorResult computeIndicators(const PriceSeriesView& series);
+    void computeIndicators(const ColumnarPriceStore& store, IndicatorColumns& out);
+    void computeIndicators(const ColumnarPriceStore& store, IndicatorColumns& out,
+                           SimdKernels::Level level);
+    std::vector<IndicatorResult> computeIndicatorsParallel(
+        const std::vector<StockData>& stocks);
+    std::vector<IndicatorResult> computeIndicatorsParallel(
+        const std::vector<StockData>& stocks, WorkStealingPool& pool);
     std::vector<IndicatorResult> computeIndicatorsParallel(
+        const std::vector<PriceSeriesView>& series);
+    // Only the stages of a compile-time IndicatorPipeline, in one fused loop
+    // per symbol; call as computeIndicatorsParallel<Pipeline>(...). Defined
+    // in IndicatorPipeline.h.
+    template<typename Pipeline>
+    std::vector<typename Pipeline::Result> computeIndicatorsParallel(
         const std::vector<StockData>& stocks);
+    template<typename Pipeline>
+    std::vector<typename Pipeline::Result> computeIndicatorsParallel(
+        const std::vector<PriceSeriesView>& series);
+    // Extended set in a single fused sweep over prices and volumes (null
+    // volumes count as zero: OBV stays 0 and VWAP falls back to the mean).
+    ExtendedIndicators computeExtendedIndicators(const PriceSeriesView& series);
+    ExtendedIndicators computeExtendedIndicators(const StockData& stockData);
+    std::vector<ExtendedIndicators> computeExtendedIndicatorsParallel(
+        const std::vector<StockData>& stocks);
+    void computeIndicatorSeries(const StockData& stockData, const IndicatorSeries& out);
+    void computeIndicatorSeries(const double* prices, size_t length,
+                                const IndicatorSeries& out);
+    void computeIndicatorSeriesParallel(const std::vector<StockData>& stocks,
+                                        const std::vector<IndicatorSeries>& outputs);
+    void computeIndicatorSeriesParallel(const std::vector<StockData>& stocks,
+                                        const std::vector<IndicatorSeries>& outputs,
+                                        WorkStealingPool& pool);
+
+    // Interns symbols that do not carry an ID yet; run once at ingest.
+    static void internSymbols(std::vector<StockData>& stocks);
+    // The carried ID, or the interned symbol when none was assigned.
+    static SymbolTable::Id resolveSymbolId(const PriceSeriesView& series) {
+        return series.symbolId != SymbolTable::kInvalidId
+                   ? series.symbolId : SymbolTable::global().intern(series.symbol);
+    }
+    static PriceSeriesView makeView(const StockData& stockData);
+
+    static const char* signalName(Signal signal);
+    static std::string_view symbolName(const IndicatorResult& result);
+    static std::string_view symbolName(SymbolTable::Id id);
+    static Signal classifySignal(double sma20, double sma50, double rsi,
+                                 double macd, double macdSignal);
+    static double calculateSignalStrength(double sma20, double sma50, double rsi,
+                                          double macd, double macdSignal);
+
+    // Single-indicator snapshots of the last bar, as used by
+    // computeIndicators; public so each kernel can be benchmarked alone.
+    double calculateSMA(const double* prices, size_t length, int period);
+    double calculateRSI(const double* prices, size_t length, int period = 14);
+    std::pair<double, double> calculateMACD(const double* prices, size_t length);
 
 private:
-    double calculateSMA(const std::vector<double>& prices, int period);
-    double calculateRSI(const std::vector<double>& prices, int period = 14);
-    std::pair<double, double> calculateMACD(const std::vector<double>& prices);
-    std::string generateSignal(const IndicatorResult& result);
+    Signal generateSignal(const IndicatorResult& result);
     double calculateSignalStrength(const IndicatorResult& result);
+    void computeColumnRow(const double* prices, size_t length,
+                          IndicatorColumns& out, size_t row);
 };
 
+static_assert(std::is_trivially_copyable<TechnicalIndicator::IndicatorResult>::value,
+              "IndicatorResult must stay trivially copyable");
+static_assert(std::is_standard_layout<TechnicalIndicator::IndicatorResult>::value,
+              "IndicatorResult must stay standard layout");
+static_assert(std::is_trivially_copyable<TechnicalIndicator::ExtendedIndicators>::value,
+              "ExtendedIndicators must stay trivially copyable");
+
 #endif
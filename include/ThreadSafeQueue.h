@@ -1,78 +1,117 @@
 #ifndef THREAD_SAFE_QUEUE_H
 #define THREAD_SAFE_QUEUE_H
 
+#include "ConcurrentQueue.h"
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <optional>
 
 template<typename T>
-class ThreadSafeQueue {
+class ThreadSafeQueue : public ConcurrentQueue<T> {
 public:
     ThreadSafeQueue() = default;
-    ~ThreadSafeQueue() = default;
+    ~ThreadSafeQueue() override = default;
 
     ThreadSafeQueue(const ThreadSafeQueue&) = delete;
     ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
 
-    void push(const T& item) {
+    void push(const T& item) override {
         std::lock_guard<std::mutex> lock(mutex_);
         queue_.push(item);
         condition_.notify_one();
     }
 
-    void push(T&& item) {
+    void push(T&& item) override {
         std::lock_guard<std::mutex> lock(mutex_);
         queue_.push(std::move(item));
         condition_.notify_one();
     }
 
+    size_t pushBulk(const T* items, size_t count) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < count; ++i) {
+            queue_.push(items[i]);
+        }
+        condition_.notify_all();
+        return count;
+    }
+
+    size_t pushBulkMove(T* items, size_t count) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < count; ++i) {
+            queue_.push(std::move(items[i]));
+        }
+        condition_.notify_all();
+        return count;
+    }
+
     T pop() {
         std::unique_lock<std::mutex> lock(mutex_);
         condition_.wait(lock, [this] { return !queue_.empty() || stop_; });
-        
+
         if (stop_ && queue_.empty()) {
             return T{};
         }
-        
+
         T item = std::move(queue_.front());
         queue_.pop();
         return item;
     }
 
-    std::optional<T> tryPop() {
+    std::optional<T> tryPop() override {
         std::lock_guard<std::mutex> lock(mutex_);
         if (queue_.empty()) {
             return std::nullopt;
         }
-        
+
         T item = std::move(queue_.front());
         queue_.pop();
         return item;
     }
 
-    bool empty() const {
+    size_t popBulk(T* out, size_t maxItems) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return drain(out, maxItems);
+    }
+
+    size_t waitPopBulk(T* out, size_t maxItems, std::chrono::nanoseconds timeout) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait_for(lock, timeout, [this] { return !queue_.empty() || stop_; });
+        return drain(out, maxItems);
+    }
+
+    bool empty() const override {
         std::lock_guard<std::mutex> lock(mutex_);
         return queue_.empty();
     }
 
-    size_t size() const {
+    size_t size() const override {
         std::lock_guard<std::mutex> lock(mutex_);
         return queue_.size();
     }
 
-    void stop() {
+    void stop() override {
         std::lock_guard<std::mutex> lock(mutex_);
         stop_ = true;
         condition_.notify_all();
     }
 
-    void reset() {
+    void reset() override {
         std::lock_guard<std::mutex> lock(mutex_);
         stop_ = false;
     }
 
 private:
+    size_t drain(T* out, size_t maxItems) {
+        size_t count = 0;
+        while (count < maxItems && !queue_.empty()) {
+            out[count++] = std::move(queue_.front());
+            queue_.pop();
+        }
+        return count;
+    }
+
     mutable std::mutex mutex_;
     std::condition_variable condition_;
     std::queue<T> queue_;
@@ -0,0 +1,78 @@
+#ifndef TIMER_QUEUE_H
+#define TIMER_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+// Deadline heap of one-shot and periodic timers. run() executes due
+// callbacks on the calling thread and otherwise sleeps on a condition
+// variable until the earliest deadline, so an idle loop costs no wakeups
+// and intervals are not quantized to a polling period. stop() wakes run()
+// immediately.
+//
+// Periodic timers keep a fixed rate (next deadline = previous deadline +
+// interval); ticks missed while a callback overran are skipped rather
+// than replayed back to back.
+class TimerQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;
+
+    TimerQueue();
+
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+
+    // First run at due; interval zero makes the timer one-shot. May be
+    // called from any thread, including from inside a callback.
+    TimerId scheduleAt(Clock::time_point due, Clock::duration interval, Callback callback);
+    TimerId schedule(Clock::duration interval, Callback callback) {
+        return scheduleAt(Clock::now() + interval, interval, std::move(callback));
+    }
+    TimerId scheduleOnce(Clock::duration delay, Callback callback) {
+        return scheduleAt(Clock::now() + delay, Clock::duration::zero(), std::move(callback));
+    }
+    // Returns false if the timer already fired (one-shot) or was cancelled.
+    // A callback that is running when cancel() is called finishes normally.
+    bool cancel(TimerId id);
+
+    // Runs until stop(). Only one thread may be inside run() at a time.
+    void run();
+    void stop();
+    // Clears a previous stop() so run() can be entered again.
+    void reset();
+
+    size_t size() const;
+
+private:
+    struct Timer {
+        Clock::duration interval;
+        Callback callback;
+    };
+
+    struct Deadline {
+        Clock::time_point due;
+        TimerId id;
+        bool operator>(const Deadline& other) const {
+            return due > other.due || (due == other.due && id > other.id);
+        }
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    // Cancelled timers leave their heap entry behind; it is dropped when it
+    // reaches the top and its id is no longer in timers_.
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    std::unordered_map<TimerId, Timer> timers_;
+    TimerId nextId_;
+    bool stopped_;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef TIMESTAMPED_QUEUE_H
+#define TIMESTAMPED_QUEUE_H
+
+#include "ConcurrentQueue.h"
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// Decorator that stamps every item with its enqueue time and, as items are
+// popped, records how long each one sat in the queue (enqueue to dequeue)
+// into a histogram. The wrapped queue holds the stamped items, so capacity,
+// blocking and stop() behave exactly as the underlying implementation's.
+//
+// Only the consumer records, so the histogram keeps a single writer as long
+// as one thread pops.
+template<typename T>
+class TimestampedQueue : public ConcurrentQueue<T> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stamped {
+        T item;
+        Clock::time_point enqueued;
+    };
+
+    TimestampedQueue(std::unique_ptr<ConcurrentQueue<Stamped>> inner, LatencyHistogram& waits)
+        : inner_(std::move(inner)), waits_(waits) {}
+
+    void push(const T& item) override { inner_->push(Stamped{item, Clock::now()}); }
+    void push(T&& item) override { inner_->push(Stamped{std::move(item), Clock::now()}); }
+
+    // Items are staged with their stamp in a fixed buffer and moved on into
+    // the inner queue, so pushBulk copies each item once, as an unwrapped
+    // queue does, and pushBulkMove only moves. The whole bulk shares one
+    // enqueue time.
+    size_t pushBulk(const T* items, size_t count) override {
+        return stampBulk(items, count);
+    }
+
+    size_t pushBulkMove(T* items, size_t count) override {
+        return stampBulk(std::make_move_iterator(items), count);
+    }
+
+    std::optional<T> tryPop() override {
+        std::optional<Stamped> stamped = inner_->tryPop();
+        if (!stamped) {
+            return std::nullopt;
+        }
+        waits_.record(Clock::now() - stamped->enqueued);
+        return std::move(stamped->item);
+    }
+
+    size_t popBulk(T* out, size_t maxItems) override {
+        return drain(out, maxItems, 0);
+    }
+
+    size_t waitPopBulk(T* out, size_t maxItems, std::chrono::nanoseconds timeout) override {
+        std::array<Stamped, kChunk> buffer;
+        size_t popped = inner_->waitPopBulk(buffer.data(), std::min(kChunk, maxItems), timeout);
+        unstamp(buffer.data(), popped, out);
+        return popped == kChunk ? drain(out, maxItems, popped) : popped;
+    }
+
+    bool empty() const override { return inner_->empty(); }
+    size_t size() const override { return inner_->size(); }
+
+    void stop() override { inner_->stop(); }
+    void reset() override { inner_->reset(); }
+
+private:
+    static constexpr size_t kChunk = 64;
+
+    template<typename Iterator>
+    size_t stampBulk(Iterator items, size_t count) {
+        std::array<Stamped, kChunk> buffer;
+        const Clock::time_point now = Clock::now();
+        size_t pushed = 0;
+        while (pushed < count) {
+            size_t n = std::min(kChunk, count - pushed);
+            for (size_t i = 0; i < n; ++i) {
+                buffer[i].item = items[pushed + i];
+                buffer[i].enqueued = now;
+            }
+            size_t accepted = inner_->pushBulkMove(buffer.data(), n);
+            pushed += accepted;
+            if (accepted < n) {
+                break;  // stopped
+            }
+        }
+        return pushed;
+    }
+
+    // Non-blocking pops until maxItems or the queue runs dry; popped items
+    // already in out are counted from already.
+    size_t drain(T* out, size_t maxItems, size_t already) {
+        std::array<Stamped, kChunk> buffer;
+        while (already < maxItems) {
+            size_t wanted = std::min(kChunk, maxItems - already);
+            size_t n = inner_->popBulk(buffer.data(), wanted);
+            unstamp(buffer.data(), n, out + already);
+            already += n;
+            if (n < wanted) {
+                break;
+            }
+        }
+        return already;
+    }
+
+    void unstamp(Stamped* stamped, size_t count, T* out) {
+        const Clock::time_point now = Clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            waits_.record(now - stamped[i].enqueued);
+            out[i] = std::move(stamped[i].item);
+        }
+    }
+
+    std::unique_ptr<ConcurrentQueue<Stamped>> inner_;
+    LatencyHistogram& waits_;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include "AlignedAllocator.h"
+#include "EventCount.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent thread pool with one task deque per worker. A worker pops its
+// own deque LIFO (hot in cache) and, when empty, steals FIFO from randomly
+// chosen victims, so uneven chunks rebalance on their own instead of
+// leaving threads idle behind a static schedule.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(size_t numWorkers = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Process-wide pool sized to the hardware, created on first use.
+    static WorkStealingPool& shared();
+
+    size_t size() const { return workers_.size(); }
+
+    void submit(Task task);
+
+    template<typename F>
+    auto submitWithFuture(F&& function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(function));
+        std::future<Result> future = task->get_future();
+        submit([task] { (*task)(); });
+        return future;
+    }
+
+    // Runs body(begin, end) for every [bounds[i], bounds[i + 1]) range and
+    // returns when all have finished. The calling thread helps execute
+    // tasks while it waits, so nested calls from a worker cannot deadlock.
+    void parallelFor(const std::vector<size_t>& bounds,
+                     const std::function<void(size_t, size_t)>& body);
+
+    // Splits items into contiguous ranges of roughly equal total cost,
+    // aiming for targetChunks ranges. A single item costlier than the
+    // target gets a range of its own.
+    static std::vector<size_t> partitionByCost(const std::vector<size_t>& costs,
+                                               size_t targetChunks);
+
+private:
+    struct alignas(kCacheLineSize) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void enqueue(Task task);
+    void workerLoop(size_t index);
+    bool runOne(size_t self, uint64_t& rngState);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t victim, Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> queuedTasks_;
+    std::atomic<size_t> nextQueue_;
+    EventCount workAvailable_;
+    EventCount chunkFinished_;
+};
+
+#endif
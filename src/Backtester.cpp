@@ -0,0 +1,179 @@
+#include "../include/Backtester.h"
+#include "../include/IncrementalIndicator.h"
+#include "../include/ScratchArena.h"
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <string>
+
+namespace {
+
+struct Account {
+    double cash = 0.0;
+    double shares = 0.0;       // negative when short
+    int direction = 0;         // +1 long, -1 short, 0 flat
+    double entryPrice = 0.0;
+    double entryCost = 0.0;
+    double peak = 0.0;
+    bool hasOrder = false;
+    int orderDirection = 0;
+    double orderScale = 1.0;
+};
+
+void closePosition(Account& account, const Backtester::Params& params, double price,
+                   Backtester::Report& report) {
+    double proceeds = account.shares * price;
+    double cost = std::abs(proceeds) * params.costBps * 1e-4;
+    double tradePnl = account.shares * (price - account.entryPrice) - account.entryCost - cost;
+    account.cash += proceeds - cost;
+    report.costs += cost;
+    ++report.trades;
+    if (tradePnl > 0) {
+        ++report.winningTrades;
+    }
+    account.shares = 0.0;
+    account.direction = 0;
+}
+
+void openPosition(Account& account, const Backtester::Params& params, double price,
+                  int direction, double scale, Backtester::Report& report) {
+    double notional = account.cash * params.positionFraction * scale;
+    if (notional <= 0.0 || price <= 0.0) {
+        return;
+    }
+    double cost = notional * params.costBps * 1e-4;
+    account.shares = direction * notional / price;
+    account.cash -= account.shares * price + cost;
+    account.direction = direction;
+    account.entryPrice = price;
+    account.entryCost = cost;
+    report.costs += cost;
+}
+
+void markToMarket(Account& account, double price, Backtester::Report& report) {
+    double equity = account.cash + account.shares * price;
+    account.peak = std::max(account.peak, equity);
+    if (account.peak > 0.0) {
+        report.maxDrawdown = std::max(report.maxDrawdown, (account.peak - equity) / account.peak);
+    }
+}
+
+}
+
+void Backtester::runBlock(const TechnicalIndicator::PriceSeriesView& series, const Params* params,
+                          size_t count, size_t firstIndex, Report* out) const {
+    const SymbolTable::Id symbolId = TechnicalIndicator::resolveSymbolId(series);
+    IncrementalIndicator indicator{std::string(series.symbol), symbolId};
+    ScratchArena::Scope scratch;
+    Account* accounts = ScratchArena::local().allocateArray<Account>(count);
+    for (size_t p = 0; p < count; ++p) {
+        new (&accounts[p]) Account();
+        accounts[p].cash = params[p].initialCapital;
+        accounts[p].peak = params[p].initialCapital;
+        out[p] = Report();
+        out[p].symbolId = symbolId;
+        out[p].params = firstIndex + p;
+        out[p].bars = series.length;
+    }
+
+    const double* prices = series.prices;
+    const size_t length = series.length;
+    for (size_t t = 0; t < length; ++t) {
+        double price = prices[t];
+
+        // Orders decided at the previous close fill at this one
+        for (size_t p = 0; p < count; ++p) {
+            Account& account = accounts[p];
+            if (account.hasOrder) {
+                if (account.direction != 0) {
+                    closePosition(account, params[p], price, out[p]);
+                }
+                if (account.orderDirection != 0) {
+                    openPosition(account, params[p], price, account.orderDirection,
+                                 account.orderScale, out[p]);
+                }
+                account.hasOrder = false;
+            }
+            markToMarket(account, price, out[p]);
+        }
+
+        if (t + 1 == length) {
+            break;  // a signal on the last bar could never be filled
+        }
+        TechnicalIndicator::IndicatorResult signal = indicator.update(price);
+
+        for (size_t p = 0; p < count; ++p) {
+            const Params& param = params[p];
+            Account& account = accounts[p];
+            if (t + 1 < param.warmupBars || signal.signal_strength < param.minStrength) {
+                continue;
+            }
+            int target = account.direction;
+            if (signal.signal == TechnicalIndicator::Signal::Buy) {
+                target = 1;
+            } else if (signal.signal == TechnicalIndicator::Signal::Sell) {
+                target = param.allowShort ? -1 : 0;
+            }
+            if (target != account.direction) {
+                account.hasOrder = true;
+                account.orderDirection = target;
+                account.orderScale = param.sizing == Sizing::StrengthScaled && param.strengthScale > 0
+                    ? std::min(1.0, signal.signal_strength / param.strengthScale) : 1.0;
+            }
+        }
+    }
+
+    for (size_t p = 0; p < count; ++p) {
+        Account& account = accounts[p];
+        if (account.direction != 0) {
+            closePosition(account, params[p], prices[length - 1], out[p]);
+            markToMarket(account, prices[length - 1], out[p]);
+        }
+        out[p].finalEquity = account.cash;
+        out[p].pnl = account.cash - params[p].initialCapital;
+        out[p].totalReturn = params[p].initialCapital > 0
+            ? out[p].pnl / params[p].initialCapital : 0.0;
+    }
+}
+
+Backtester::Report Backtester::run(const TechnicalIndicator::PriceSeriesView& series,
+                                   const Params& params) const {
+    Report report;
+    runBlock(series, &params, 1, 0, &report);
+    return report;
+}
+
+std::vector<Backtester::Report> Backtester::run(
+    const std::vector<TechnicalIndicator::StockData>& stocks,
+    const std::vector<Params>& params) const {
+
+    std::vector<TechnicalIndicator::PriceSeriesView> series;
+    series.reserve(stocks.size());
+    for (const auto& stock : stocks) {
+        series.push_back(TechnicalIndicator::makeView(stock));
+    }
+    return run(series, params);
+}
+
+std::vector<Backtester::Report> Backtester::run(
+    const std::vector<TechnicalIndicator::PriceSeriesView>& series,
+    const std::vector<Params>& params) const {
+
+    std::vector<Report> reports(series.size() * params.size());
+    const long numBlocks = static_cast<long>((params.size() + kParamBlock - 1) / kParamBlock);
+    const long tasks = static_cast<long>(series.size()) * numBlocks;
+
+    // Dynamic scheduling because task cost follows series length
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+    #endif
+    for (long task = 0; task < tasks; ++task) {
+        size_t s = static_cast<size_t>(task / numBlocks);
+        size_t first = static_cast<size_t>(task % numBlocks) * kParamBlock;
+        size_t count = std::min(kParamBlock, params.size() - first);
+        runBlock(series[s], params.data() + first, count, first,
+                 reports.data() + s * params.size() + first);
+    }
+
+    return reports;
+}
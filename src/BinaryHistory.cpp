@@ -0,0 +1,230 @@
+#include "../include/BinaryHistory.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+uint64_t alignUp(uint64_t value) {
+    const uint64_t alignment = BinaryHistory::kColumnAlignment;
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t columnBytes(uint64_t length) {
+    return alignUp(length * sizeof(double));
+}
+
+// True if count elements of elementSize bytes starting at offset lie within
+// size bytes. Divides instead of multiplying so a corrupt count or offset
+// cannot wrap around and pass.
+bool fitsWithin(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t size) {
+    return offset <= size && count <= (size - offset) / elementSize;
+}
+
+class FileWriter {
+public:
+    explicit FileWriter(const std::string& path)
+        : file_(std::fopen(path.c_str(), "wb")), path_(path) {
+        if (!file_) {
+            throw std::runtime_error("Cannot open " + path + " for writing");
+        }
+    }
+
+    ~FileWriter() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    void write(const void* data, size_t bytes) {
+        if (bytes > 0 && std::fwrite(data, 1, bytes, file_) != bytes) {
+            throw std::runtime_error("Write failed for " + path_);
+        }
+        written_ += bytes;
+    }
+
+    void padTo(uint64_t offset) {
+        static const char zeros[BinaryHistory::kColumnAlignment] = {};
+        while (written_ < offset) {
+            write(zeros, std::min<uint64_t>(sizeof(zeros), offset - written_));
+        }
+    }
+
+    void writeColumn(const std::vector<double>& column, uint64_t length) {
+        size_t available = std::min<size_t>(column.size(), length);
+        write(column.data(), available * sizeof(double));
+        padTo(written_ + (length - available) * sizeof(double));
+    }
+
+    void close() {
+        if (std::fclose(file_) != 0) {
+            file_ = nullptr;
+            throw std::runtime_error("Close failed for " + path_);
+        }
+        file_ = nullptr;
+    }
+
+private:
+    std::FILE* file_;
+    std::string path_;
+    uint64_t written_ = 0;
+};
+
+}
+
+void BinaryHistory::write(const std::string& path,
+                          const std::vector<TechnicalIndicator::StockData>& stocks) {
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrderMark = kByteOrderMark;
+    header.numSymbols = stocks.size();
+    header.directoryOffset = sizeof(FileHeader);
+
+    std::vector<DirectoryEntry> directory(stocks.size());
+    uint64_t offset = alignUp(header.directoryOffset + stocks.size() * sizeof(DirectoryEntry));
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        const auto& stock = stocks[i];
+        if (stock.symbol.size() >= kSymbolCapacity) {
+            throw std::runtime_error("Symbol too long for binary history: " + stock.symbol);
+        }
+
+        DirectoryEntry& entry = directory[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.symbol, stock.symbol.data(), stock.symbol.size());
+        entry.length = stock.prices.size();
+        entry.pricesOffset = offset;
+        entry.volumesOffset = entry.pricesOffset + columnBytes(entry.length);
+        entry.timestampsOffset = entry.volumesOffset + columnBytes(entry.length);
+        offset = entry.timestampsOffset + columnBytes(entry.length);
+        header.totalBars += entry.length;
+    }
+    header.fileSize = offset;
+
+    FileWriter writer(path);
+    writer.write(&header, sizeof(header));
+    writer.write(directory.data(), directory.size() * sizeof(DirectoryEntry));
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        const DirectoryEntry& entry = directory[i];
+        writer.padTo(entry.pricesOffset);
+        writer.writeColumn(stocks[i].prices, entry.length);
+        writer.padTo(entry.volumesOffset);
+        writer.writeColumn(stocks[i].volumes, entry.length);
+        writer.padTo(entry.timestampsOffset);
+        writer.writeColumn(stocks[i].timestamps, entry.length);
+    }
+    writer.padTo(header.fileSize);
+    writer.close();
+}
+
+MappedHistory::MappedHistory(const std::string& path)
+    : base_(nullptr), mappedBytes_(0), numSymbols_(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryHistory::FileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Not a binary history file: " + path);
+    }
+
+    mappedBytes_ = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, mappedBytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("mmap failed for " + path);
+    }
+    base_ = static_cast<const unsigned char*>(mapping);
+
+    const auto* header = reinterpret_cast<const BinaryHistory::FileHeader*>(base_);
+    bool valid = std::memcmp(header->magic, BinaryHistory::kMagic, sizeof(header->magic)) == 0 &&
+                 header->version == BinaryHistory::kVersion &&
+                 header->byteOrderMark == BinaryHistory::kByteOrderMark &&
+                 header->fileSize == mappedBytes_ &&
+                 header->directoryOffset % alignof(BinaryHistory::DirectoryEntry) == 0 &&
+                 fitsWithin(header->directoryOffset, header->numSymbols,
+                            sizeof(BinaryHistory::DirectoryEntry), mappedBytes_);
+    if (valid) {
+        numSymbols_ = static_cast<size_t>(header->numSymbols);
+        for (size_t i = 0; i < numSymbols_ && valid; ++i) {
+            const auto& e = entry(i);
+            valid = e.symbol[BinaryHistory::kSymbolCapacity - 1] == '\0' &&
+                    e.pricesOffset % BinaryHistory::kColumnAlignment == 0 &&
+                    e.volumesOffset % BinaryHistory::kColumnAlignment == 0 &&
+                    e.timestampsOffset % BinaryHistory::kColumnAlignment == 0 &&
+                    fitsWithin(e.pricesOffset, e.length, sizeof(double), mappedBytes_) &&
+                    fitsWithin(e.volumesOffset, e.length, sizeof(double), mappedBytes_) &&
+                    fitsWithin(e.timestampsOffset, e.length, sizeof(double), mappedBytes_);
+        }
+    }
+    if (!valid) {
+        ::munmap(const_cast<unsigned char*>(base_), mappedBytes_);
+        throw std::runtime_error("Corrupt or incompatible binary history file: " + path);
+    }
+
+    symbolIds_.reserve(numSymbols_);
+    for (size_t i = 0; i < numSymbols_; ++i) {
+        const auto& e = entry(i);
+        symbolIds_.push_back(SymbolTable::global().intern(
+            std::string_view(e.symbol, ::strnlen(e.symbol, BinaryHistory::kSymbolCapacity))));
+    }
+}
+
+MappedHistory::~MappedHistory() {
+    if (base_) {
+        ::munmap(const_cast<unsigned char*>(base_), mappedBytes_);
+    }
+}
+
+const BinaryHistory::DirectoryEntry& MappedHistory::entry(size_t index) const {
+    const auto* header = reinterpret_cast<const BinaryHistory::FileHeader*>(base_);
+    const auto* directory = reinterpret_cast<const BinaryHistory::DirectoryEntry*>(
+        base_ + header->directoryOffset);
+    return directory[index];
+}
+
+size_t MappedHistory::totalBars() const {
+    return static_cast<size_t>(reinterpret_cast<const BinaryHistory::FileHeader*>(base_)->totalBars);
+}
+
+TechnicalIndicator::PriceSeriesView MappedHistory::series(size_t index) const {
+    const auto& e = entry(index);
+    TechnicalIndicator::PriceSeriesView view;
+    view.symbol = std::string_view(e.symbol, ::strnlen(e.symbol, BinaryHistory::kSymbolCapacity));
+    view.prices = reinterpret_cast<const double*>(base_ + e.pricesOffset);
+    view.volumes = reinterpret_cast<const double*>(base_ + e.volumesOffset);
+    view.timestamps = reinterpret_cast<const double*>(base_ + e.timestampsOffset);
+    view.length = static_cast<size_t>(e.length);
+    view.symbolId = symbolIds_[index];
+    return view;
+}
+
+std::vector<TechnicalIndicator::PriceSeriesView> MappedHistory::views() const {
+    std::vector<TechnicalIndicator::PriceSeriesView> result;
+    result.reserve(numSymbols_);
+    for (size_t i = 0; i < numSymbols_; ++i) {
+        result.push_back(series(i));
+    }
+    return result;
+}
+
+size_t MappedHistory::find(std::string_view symbol) const {
+    for (size_t i = 0; i < numSymbols_; ++i) {
+        const auto& e = entry(i);
+        if (symbol == std::string_view(e.symbol, ::strnlen(e.symbol, BinaryHistory::kSymbolCapacity))) {
+            return i;
+        }
+    }
+    return numSymbols_;
+}
+
+void MappedHistory::prefetch() const {
+    ::madvise(const_cast<unsigned char*>(base_), mappedBytes_, MADV_WILLNEED);
+}
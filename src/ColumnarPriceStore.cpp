@@ -0,0 +1,53 @@
+#include "../include/ColumnarPriceStore.h"
+
+template<typename T>
+BasicColumnarPriceStore<T>::BasicColumnarPriceStore()
+    : offsets_(1, 0) {
+}
+
+template<typename T>
+BasicColumnarPriceStore<T> BasicColumnarPriceStore<T>::fromStockData(
+    const std::vector<TechnicalIndicator::StockData>& stocks) {
+
+    size_t totalPrices = 0;
+    for (const auto& stock : stocks) {
+        totalPrices += stock.prices.size();
+    }
+
+    BasicColumnarPriceStore store;
+    store.reserve(stocks.size(), totalPrices);
+    for (const auto& stock : stocks) {
+        store.addSeries(stock.symbol, stock.prices.data(), stock.prices.size(), stock.symbolId);
+    }
+    return store;
+}
+
+template<typename T>
+void BasicColumnarPriceStore<T>::reserve(size_t numSymbols, size_t totalPrices) {
+    symbols_.reserve(numSymbols);
+    symbolIds_.reserve(numSymbols);
+    offsets_.reserve(numSymbols + 1);
+    arena_.reserve(totalPrices);
+}
+
+template<typename T>
+size_t BasicColumnarPriceStore<T>::addSeries(const std::string& symbol, const double* prices,
+                                             size_t length, SymbolTable::Id symbolId) {
+    arena_.insert(arena_.end(), prices, prices + length);
+    offsets_.push_back(arena_.size());
+    symbols_.push_back(symbol);
+    symbolIds_.push_back(symbolId != SymbolTable::kInvalidId ? symbolId
+                                                             : SymbolTable::global().intern(symbol));
+    return symbols_.size() - 1;
+}
+
+template<typename T>
+void BasicColumnarPriceStore<T>::clear() {
+    symbols_.clear();
+    symbolIds_.clear();
+    offsets_.assign(1, 0);
+    arena_.clear();
+}
+
+template class BasicColumnarPriceStore<double>;
+template class BasicColumnarPriceStore<float>;
@@ -0,0 +1,239 @@
+#include "../include/CorrelationEngine.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr size_t kMicro = 4;
+
+// acc[r][c] += dot(a[r][k0..k1), b[c][k0..k1)) for a 4x4 block of pairs;
+// each loaded return feeds four products.
+inline void multiplyBlock(const double* const a[kMicro], const double* const b[kMicro],
+                          size_t k0, size_t k1, double acc[kMicro][kMicro]) {
+    double c00 = 0, c01 = 0, c02 = 0, c03 = 0;
+    double c10 = 0, c11 = 0, c12 = 0, c13 = 0;
+    double c20 = 0, c21 = 0, c22 = 0, c23 = 0;
+    double c30 = 0, c31 = 0, c32 = 0, c33 = 0;
+    for (size_t k = k0; k < k1; ++k) {
+        double a0 = a[0][k], a1 = a[1][k], a2 = a[2][k], a3 = a[3][k];
+        double b0 = b[0][k], b1 = b[1][k], b2 = b[2][k], b3 = b[3][k];
+        c00 += a0 * b0; c01 += a0 * b1; c02 += a0 * b2; c03 += a0 * b3;
+        c10 += a1 * b0; c11 += a1 * b1; c12 += a1 * b2; c13 += a1 * b3;
+        c20 += a2 * b0; c21 += a2 * b1; c22 += a2 * b2; c23 += a2 * b3;
+        c30 += a3 * b0; c31 += a3 * b1; c32 += a3 * b2; c33 += a3 * b3;
+    }
+    acc[0][0] += c00; acc[0][1] += c01; acc[0][2] += c02; acc[0][3] += c03;
+    acc[1][0] += c10; acc[1][1] += c11; acc[1][2] += c12; acc[1][3] += c13;
+    acc[2][0] += c20; acc[2][1] += c21; acc[2][2] += c22; acc[2][3] += c23;
+    acc[3][0] += c30; acc[3][1] += c31; acc[3][2] += c32; acc[3][3] += c33;
+}
+
+}
+
+CorrelationEngine::CorrelationEngine(size_t window) : window_(window) {
+    if (window_ < 2) {
+        throw std::invalid_argument("CorrelationEngine: window must be at least 2");
+    }
+    stride_ = paddedToCacheLine<double>(window_);
+}
+
+void CorrelationEngine::compute(const std::vector<TechnicalIndicator::StockData>& stocks) {
+    std::vector<TechnicalIndicator::PriceSeriesView> series;
+    series.reserve(stocks.size());
+    for (const auto& stock : stocks) {
+        series.push_back(TechnicalIndicator::makeView(stock));
+    }
+    compute(series);
+}
+
+void CorrelationEngine::compute(const std::vector<TechnicalIndicator::PriceSeriesView>& series) {
+    for (const auto& s : series) {
+        if (s.length < window_ + 1) {
+            throw std::invalid_argument("CorrelationEngine: " + std::string(s.symbol) + " has " +
+                                        std::to_string(s.length) + " prices, need " +
+                                        std::to_string(window_ + 1));
+        }
+    }
+
+    size_ = series.size();
+    returns_.assign(size_ * stride_, 0.0);
+    lastClose_.resize(size_);
+    const long n = static_cast<long>(size_);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < n; ++i) {
+        const double* prices = series[i].prices + series[i].length - (window_ + 1);
+        double* row = returns_.data() + i * stride_;
+        for (size_t k = 0; k < window_; ++k) {
+            row[k] = prices[k] > 0.0 ? prices[k + 1] / prices[k] - 1.0 : 0.0;
+        }
+        lastClose_[i] = prices[window_];
+    }
+    head_ = 0;
+    rebuild();
+}
+
+void CorrelationEngine::rebuild() {
+    const long n = static_cast<long>(size_);
+    shift_.assign(size_, 0.0);
+    sums_.assign(size_, 0.0);
+    products_.assign(size_ * (size_ + 1) / 2, 0.0);
+
+    // Shifted copy; the padding columns stay zero and add nothing.
+    AlignedVector<double> shifted(size_ * stride_, 0.0);
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < n; ++i) {
+        const double* row = returns_.data() + i * stride_;
+        double mean = 0.0;
+        for (size_t k = 0; k < window_; ++k) {
+            mean += row[k];
+        }
+        mean /= window_;
+        double* out = shifted.data() + i * stride_;
+        double sum = 0.0;
+        for (size_t k = 0; k < window_; ++k) {
+            out[k] = row[k] - mean;
+            sum += out[k];
+        }
+        shift_[i] = mean;
+        sums_[i] = sum;
+    }
+
+    const size_t tiles = (size_ + kTile - 1) / kTile;
+    std::vector<std::pair<size_t, size_t>> tilePairs;
+    for (size_t bi = 0; bi < tiles; ++bi) {
+        for (size_t bj = bi; bj < tiles; ++bj) {
+            tilePairs.emplace_back(bi, bj);
+        }
+    }
+    const long numPairs = static_cast<long>(tilePairs.size());
+
+    // Diagonal tiles do about half the work of the others
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+    #endif
+    for (long p = 0; p < numPairs; ++p) {
+        size_t i0 = tilePairs[p].first * kTile, i1 = std::min(size_, i0 + kTile);
+        size_t j0 = tilePairs[p].second * kTile, j1 = std::min(size_, j0 + kTile);
+        bool diagonal = i0 == j0;
+        std::array<std::array<double, kTile>, kTile> acc{};
+
+        for (size_t k0 = 0; k0 < window_; k0 += kDepth) {
+            size_t k1 = std::min(window_, k0 + kDepth);
+            for (size_t i = i0; i < i1; i += kMicro) {
+                const double* a[kMicro];
+                for (size_t r = 0; r < kMicro; ++r) {
+                    a[r] = shifted.data() + std::min(i + r, i1 - 1) * stride_;
+                }
+                for (size_t j = diagonal ? i : j0; j < j1; j += kMicro) {
+                    const double* b[kMicro];
+                    for (size_t c = 0; c < kMicro; ++c) {
+                        b[c] = shifted.data() + std::min(j + c, j1 - 1) * stride_;
+                    }
+                    double block[kMicro][kMicro] = {};
+                    multiplyBlock(a, b, k0, k1, block);
+                    for (size_t r = 0; r < kMicro && i + r < i1; ++r) {
+                        for (size_t c = 0; c < kMicro && j + c < j1; ++c) {
+                            acc[i + r - i0][j + c - j0] += block[r][c];
+                        }
+                    }
+                }
+            }
+        }
+
+        for (size_t i = i0; i < i1; ++i) {
+            for (size_t j = diagonal ? i : j0; j < j1; ++j) {
+                products_[packedIndex(i, j)] = acc[i - i0][j - j0];
+            }
+        }
+    }
+    updatesSinceRebuild_ = 0;
+}
+
+void CorrelationEngine::update(const std::vector<double>& closes) {
+    if (closes.size() != size_) {
+        throw std::invalid_argument("CorrelationEngine: expected " + std::to_string(size_) +
+                                    " closes, got " + std::to_string(closes.size()));
+    }
+
+    // Shifted value entering and leaving the window for each symbol
+    std::vector<double> entering(size_), leaving(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        double r = lastClose_[i] > 0.0 ? closes[i] / lastClose_[i] - 1.0 : 0.0;
+        double& slot = returns_[i * stride_ + head_];
+        leaving[i] = slot - shift_[i];
+        entering[i] = r - shift_[i];
+        slot = r;
+        lastClose_[i] = closes[i];
+        sums_[i] += entering[i] - leaving[i];
+    }
+    head_ = (head_ + 1) % window_;
+
+    if (++updatesSinceRebuild_ >= window_) {
+        rebuild();
+        return;
+    }
+
+    const long n = static_cast<long>(size_);
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+    #endif
+    for (long i = 0; i < n; ++i) {
+        double* row = products_.data() + packedIndex(i, i);
+        double in = entering[i], out = leaving[i];
+        for (size_t j = i; j < size_; ++j) {
+            row[j - i] += in * entering[j] - out * leaving[j];
+        }
+    }
+}
+
+double CorrelationEngine::covariance(size_t i, size_t j) const {
+    if (i > j) {
+        std::swap(i, j);
+    }
+    return (products_[packedIndex(i, j)] - sums_[i] * sums_[j] / window_) / (window_ - 1);
+}
+
+double CorrelationEngine::correlation(size_t i, size_t j) const {
+    double varI = covariance(i, i);
+    double varJ = covariance(j, j);
+    if (varI <= 0.0 || varJ <= 0.0) {
+        return 0.0;
+    }
+    return covariance(i, j) / std::sqrt(varI * varJ);
+}
+
+std::vector<double> CorrelationEngine::covarianceMatrix() const {
+    std::vector<double> matrix(size_ * size_);
+    for (size_t i = 0; i < size_; ++i) {
+        for (size_t j = i; j < size_; ++j) {
+            matrix[i * size_ + j] = matrix[j * size_ + i] = covariance(i, j);
+        }
+    }
+    return matrix;
+}
+
+std::vector<double> CorrelationEngine::correlationMatrix() const {
+    std::vector<double> stddev(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        double variance = covariance(i, i);
+        stddev[i] = variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+    std::vector<double> matrix(size_ * size_);
+    for (size_t i = 0; i < size_; ++i) {
+        for (size_t j = i; j < size_; ++j) {
+            double denom = stddev[i] * stddev[j];
+            matrix[i * size_ + j] = matrix[j * size_ + i] =
+                denom > 0.0 ? covariance(i, j) / denom : 0.0;
+        }
+    }
+    return matrix;
+}
@@ -0,0 +1,146 @@
+#include "../include/IncrementalIndicator.h"
+
+namespace {
+
+constexpr double kFastMultiplier = 2.0 / (IncrementalIndicator::kFastPeriod + 1);
+constexpr double kSlowMultiplier = 2.0 / (IncrementalIndicator::kSlowPeriod + 1);
+constexpr double kSignalMultiplier = 2.0 / (IncrementalIndicator::kSignalPeriod + 1);
+
+}
+
+IncrementalIndicator::IncrementalIndicator(const std::string& symbol)
+    : symbol_(symbol), symbolId_(SymbolTable::global().intern(symbol)) {
+    reset();
+}
+
+IncrementalIndicator::IncrementalIndicator(const std::string& symbol, SymbolTable::Id symbolId)
+    : symbol_(symbol), symbolId_(symbolId) {
+    reset();
+}
+
+void IncrementalIndicator::reset() {
+    window_.fill(0.0);
+    head_ = 0;
+    count_ = 0;
+    sum20_ = 0.0;
+    sum50_ = 0.0;
+    lastPrice_ = 0.0;
+    avgGain_ = 0.0;
+    avgLoss_ = 0.0;
+    ema12_ = 0.0;
+    ema26_ = 0.0;
+    signalEma_ = 0.0;
+}
+
+void IncrementalIndicator::push(double price) {
+    if (count_ == 0) {
+        ema12_ = price;
+        ema26_ = price;
+    } else {
+        double change = price - lastPrice_;
+        double gain = change > 0 ? change : 0.0;
+        double loss = change > 0 ? 0.0 : -change;
+
+        // count_ is now the number of changes seen, including this one
+        if (count_ < static_cast<size_t>(kRsiPeriod)) {
+            avgGain_ += gain;
+            avgLoss_ += loss;
+        } else if (count_ == static_cast<size_t>(kRsiPeriod)) {
+            avgGain_ = (avgGain_ + gain) / kRsiPeriod;
+            avgLoss_ = (avgLoss_ + loss) / kRsiPeriod;
+        } else {
+            avgGain_ = (avgGain_ * (kRsiPeriod - 1) + gain) / kRsiPeriod;
+            avgLoss_ = (avgLoss_ * (kRsiPeriod - 1) + loss) / kRsiPeriod;
+        }
+
+        ema12_ = (price - ema12_) * kFastMultiplier + ema12_;
+        ema26_ = (price - ema26_) * kSlowMultiplier + ema26_;
+
+        size_t bars = count_ + 1;
+        if (bars == static_cast<size_t>(kSlowPeriod)) {
+            signalEma_ = ema12_ - ema26_;
+        } else if (bars > static_cast<size_t>(kSlowPeriod)) {
+            signalEma_ = (ema12_ - ema26_ - signalEma_) * kSignalMultiplier + signalEma_;
+        }
+    }
+
+    if (count_ >= static_cast<size_t>(kShortPeriod)) {
+        sum20_ -= window_[(head_ + kLongPeriod - kShortPeriod) % kLongPeriod];
+    }
+    if (count_ >= static_cast<size_t>(kLongPeriod)) {
+        sum50_ -= window_[head_];
+    }
+    window_[head_] = price;
+    sum20_ += price;
+    sum50_ += price;
+    lastPrice_ = price;
+    ++count_;
+
+    head_ = (head_ + 1) % kLongPeriod;
+    if (head_ == 0) {
+        // Once per wrap the ring is in chronological order; re-summing here
+        // keeps rounding error from accumulating over long streams.
+        sum50_ = 0.0;
+        for (int i = 0; i < kLongPeriod; ++i) {
+            sum50_ += window_[i];
+        }
+        sum20_ = 0.0;
+        for (int i = kLongPeriod - kShortPeriod; i < kLongPeriod; ++i) {
+            sum20_ += window_[i];
+        }
+    }
+}
+
+TechnicalIndicator::IndicatorResult IncrementalIndicator::update(double price) {
+    push(price);
+    return result();
+}
+
+double IncrementalIndicator::sma20() const {
+    return count_ >= static_cast<size_t>(kShortPeriod) ? sum20_ / kShortPeriod : 0.0;
+}
+
+double IncrementalIndicator::sma50() const {
+    return count_ >= static_cast<size_t>(kLongPeriod) ? sum50_ / kLongPeriod : 0.0;
+}
+
+double IncrementalIndicator::rsi() const {
+    if (count_ <= static_cast<size_t>(kRsiPeriod)) {
+        return 50.0;
+    }
+    if (avgLoss_ == 0.0) {
+        return 100.0;
+    }
+    double rs = avgGain_ / avgLoss_;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+double IncrementalIndicator::macd() const {
+    return count_ >= static_cast<size_t>(kSlowPeriod) ? ema12_ - ema26_ : 0.0;
+}
+
+double IncrementalIndicator::macdSignal() const {
+    return count_ >= static_cast<size_t>(kSlowPeriod) ? signalEma_ : 0.0;
+}
+
+TechnicalIndicator::IndicatorResult IncrementalIndicator::result() const {
+    TechnicalIndicator::IndicatorResult result{};
+    result.symbolId = symbolId_;
+    result.sma_20 = sma20();
+    result.sma_50 = sma50();
+    result.rsi = rsi();
+    result.macd = macd();
+    result.macd_signal = macdSignal();
+
+    if (count_ == 0) {
+        result.signal = TechnicalIndicator::Signal::Hold;
+        result.signal_strength = 0.0;
+        return result;
+    }
+
+    result.signal = TechnicalIndicator::classifySignal(
+        result.sma_20, result.sma_50, result.rsi, result.macd, result.macd_signal);
+    result.signal_strength = TechnicalIndicator::calculateSignalStrength(
+        result.sma_20, result.sma_50, result.rsi, result.macd, result.macd_signal);
+    return result;
+}
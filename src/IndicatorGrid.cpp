@@ -0,0 +1,222 @@
+#include "../include/IndicatorGrid.h"
+#include "../include/ScratchArena.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void requirePositive(const std::vector<int>& periods, const char* what) {
+    for (int period : periods) {
+        if (period <= 0) {
+            throw std::invalid_argument(std::string("IndicatorGrid: non-positive ") + what +
+                                        " period " + std::to_string(period));
+        }
+    }
+}
+
+size_t findOrAdd(std::vector<int>& periods, int period) {
+    auto found = std::find(periods.begin(), periods.end(), period);
+    if (found != periods.end()) {
+        return found - periods.begin();
+    }
+    periods.push_back(period);
+    return periods.size() - 1;
+}
+
+}
+
+IndicatorGrid::IndicatorGrid(Spec spec) : spec_(std::move(spec)) {
+    requirePositive(spec_.smaPeriods, "SMA");
+    requirePositive(spec_.rsiPeriods, "RSI");
+    for (const MacdParams& params : spec_.macdParams) {
+        requirePositive({params.fast, params.slow, params.signal}, "MACD");
+    }
+
+    size_t numBlocks = std::max<size_t>(1, std::max(
+        (spec_.rsiPeriods.size() + kBlockSize - 1) / kBlockSize,
+        (spec_.macdParams.size() + kBlockSize - 1) / kBlockSize));
+    blocks_.resize(numBlocks);
+    for (size_t i = 0; i < spec_.rsiPeriods.size(); ++i) {
+        blocks_[i / kBlockSize].rsi.push_back(i);
+    }
+    for (size_t i = 0; i < spec_.macdParams.size(); ++i) {
+        Block& block = blocks_[i / kBlockSize];
+        block.macd.push_back(i);
+        block.fastEma.push_back(findOrAdd(block.emaPeriods, spec_.macdParams[i].fast));
+        block.slowEma.push_back(findOrAdd(block.emaPeriods, spec_.macdParams[i].slow));
+    }
+}
+
+void IndicatorGrid::computeSma(const double* prices, size_t length, double* out) const {
+    ScratchArena::Scope scratch;
+    double* prefix = ScratchArena::local().allocateArray<double>(length + 1);
+    prefix[0] = 0.0;
+    for (size_t t = 0; t < length; ++t) {
+        prefix[t + 1] = prefix[t] + prices[t];
+    }
+    for (size_t j = 0; j < spec_.smaPeriods.size(); ++j) {
+        size_t period = static_cast<size_t>(spec_.smaPeriods[j]);
+        out[j] = length >= period ? (prefix[length] - prefix[length - period]) / period : 0.0;
+    }
+}
+
+void IndicatorGrid::computeBlock(const double* prices, size_t length, const Block& block,
+                                 double* rsiOut, double* macdOut, double* signalOut) const {
+    const size_t numRsi = block.rsi.size();
+    const size_t numEma = block.emaPeriods.size();
+    const size_t numMacd = block.macd.size();
+
+    // Scratch comes from the thread's arena, so tasks never touch malloc
+    ScratchArena& arena = ScratchArena::local();
+    ScratchArena::Scope scratch(arena);
+
+    size_t* rsiPeriod = arena.allocateArray<size_t>(numRsi);
+    double* avgGain = arena.allocateArray<double>(numRsi);
+    double* avgLoss = arena.allocateArray<double>(numRsi);
+    for (size_t k = 0; k < numRsi; ++k) {
+        rsiPeriod[k] = static_cast<size_t>(spec_.rsiPeriods[block.rsi[k]]);
+        avgGain[k] = avgLoss[k] = 0.0;
+    }
+
+    double* emaMultiplier = arena.allocateArray<double>(numEma);
+    double* ema = arena.allocateArray<double>(numEma);
+    for (size_t k = 0; k < numEma; ++k) {
+        emaMultiplier[k] = 2.0 / (block.emaPeriods[k] + 1);
+        ema[k] = 0.0;
+    }
+
+    size_t* macdStart = arena.allocateArray<size_t>(numMacd);
+    double* signalMultiplier = arena.allocateArray<double>(numMacd);
+    double* macd = arena.allocateArray<double>(numMacd);
+    double* signal = arena.allocateArray<double>(numMacd);
+    for (size_t k = 0; k < numMacd; ++k) {
+        const MacdParams& params = spec_.macdParams[block.macd[k]];
+        macdStart[k] = static_cast<size_t>(std::max(params.fast, params.slow));
+        signalMultiplier[k] = 2.0 / (params.signal + 1);
+        macd[k] = signal[k] = 0.0;
+    }
+
+    // One sweep advances every recurrence of the block; the arithmetic per
+    // recurrence is the same as computeIndicatorSeries so results agree
+    // bit for bit.
+    for (size_t t = 0; t < length; ++t) {
+        double price = prices[t];
+        if (t == 0) {
+            std::fill(ema, ema + numEma, price);
+        } else {
+            double change = price - prices[t - 1];
+            double gain = change > 0 ? change : 0.0;
+            double loss = change > 0 ? 0.0 : -change;
+            for (size_t k = 0; k < numRsi; ++k) {
+                size_t period = rsiPeriod[k];
+                if (t < period) {
+                    avgGain[k] += gain;
+                    avgLoss[k] += loss;
+                } else if (t == period) {
+                    avgGain[k] = (avgGain[k] + gain) / period;
+                    avgLoss[k] = (avgLoss[k] + loss) / period;
+                } else {
+                    avgGain[k] = (avgGain[k] * (period - 1) + gain) / period;
+                    avgLoss[k] = (avgLoss[k] * (period - 1) + loss) / period;
+                }
+            }
+            for (size_t k = 0; k < numEma; ++k) {
+                ema[k] = (price - ema[k]) * emaMultiplier[k] + ema[k];
+            }
+        }
+
+        for (size_t k = 0; k < numMacd; ++k) {
+            if (t + 1 < macdStart[k]) {
+                continue;
+            }
+            macd[k] = ema[block.fastEma[k]] - ema[block.slowEma[k]];
+            signal[k] = (t + 1 == macdStart[k])
+                            ? macd[k] : (macd[k] - signal[k]) * signalMultiplier[k] + signal[k];
+        }
+    }
+
+    for (size_t k = 0; k < numRsi; ++k) {
+        double value;
+        if (length == 0 || length - 1 < rsiPeriod[k]) {
+            value = 50.0;
+        } else if (avgLoss[k] == 0.0) {
+            value = 100.0;
+        } else {
+            value = 100.0 - (100.0 / (1.0 + avgGain[k] / avgLoss[k]));
+        }
+        rsiOut[block.rsi[k]] = value;
+    }
+    for (size_t k = 0; k < numMacd; ++k) {
+        macdOut[block.macd[k]] = macd[k];
+        signalOut[block.macd[k]] = signal[k];
+    }
+}
+
+IndicatorGrid::Result IndicatorGrid::compute(
+    const std::vector<TechnicalIndicator::StockData>& stocks) const {
+
+    std::vector<TechnicalIndicator::PriceSeriesView> series;
+    series.reserve(stocks.size());
+    for (const auto& stock : stocks) {
+        series.push_back(TechnicalIndicator::makeView(stock));
+    }
+    return compute(series);
+}
+
+IndicatorGrid::Result IndicatorGrid::compute(
+    const std::vector<TechnicalIndicator::PriceSeriesView>& series) const {
+
+    Result result;
+    result.symbols = series.size();
+    result.smaCount = spec_.smaPeriods.size();
+    result.rsiCount = spec_.rsiPeriods.size();
+    result.macdCount = spec_.macdParams.size();
+    result.sma.resize(result.symbols * result.smaCount);
+    result.rsi.resize(result.symbols * result.rsiCount);
+    result.macd.resize(result.symbols * result.macdCount);
+    result.macdSignal.resize(result.symbols * result.macdCount);
+
+    const long numBlocks = static_cast<long>(blocks_.size());
+    const long tasks = static_cast<long>(series.size()) * numBlocks;
+
+    // Block 0 of each symbol also owns its SMAs. Dynamic scheduling
+    // because task cost follows series length.
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+    #endif
+    for (long task = 0; task < tasks; ++task) {
+        size_t s = static_cast<size_t>(task / numBlocks);
+        size_t b = static_cast<size_t>(task % numBlocks);
+        const double* prices = series[s].prices;
+        size_t length = series[s].length;
+
+        if (b == 0) {
+            computeSma(prices, length, result.sma.data() + s * result.smaCount);
+        }
+        computeBlock(prices, length, blocks_[b],
+                     result.rsi.data() + s * result.rsiCount,
+                     result.macd.data() + s * result.macdCount,
+                     result.macdSignal.data() + s * result.macdCount);
+    }
+
+    return result;
+}
+
+TechnicalIndicator::IndicatorResult IndicatorGrid::combination(
+    const Result& result, size_t symbol, SymbolTable::Id symbolId,
+    size_t shortSma, size_t longSma, size_t rsi, size_t macd) {
+
+    TechnicalIndicator::IndicatorResult combined{};
+    combined.symbolId = symbolId;
+    combined.sma_20 = result.smaAt(symbol, shortSma);
+    combined.sma_50 = result.smaAt(symbol, longSma);
+    combined.rsi = result.rsiAt(symbol, rsi);
+    combined.macd = result.macdAt(symbol, macd);
+    combined.macd_signal = result.macdSignalAt(symbol, macd);
+    combined.signal = TechnicalIndicator::classifySignal(
+        combined.sma_20, combined.sma_50, combined.rsi, combined.macd, combined.macd_signal);
+    combined.signal_strength = TechnicalIndicator::calculateSignalStrength(
+        combined.sma_20, combined.sma_50, combined.rsi, combined.macd, combined.macd_signal);
+    return combined;
+}
@@ -0,0 +1,94 @@
+#include "../include/LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - kSubBucketBits + 1;
+    size_t sub = static_cast<size_t>(value >> shift);  // in [kHalfSubBuckets, kSubBuckets)
+    return kSubBuckets + (shift - 1) * kHalfSubBuckets + (sub - kHalfSubBuckets);
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    size_t shift = (index - kSubBuckets) / kHalfSubBuckets + 1;
+    uint64_t sub = (index - kSubBuckets) % kHalfSubBuckets + kHalfSubBuckets;
+    return sub << shift;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index + 1 >= kBuckets) {
+        return UINT64_MAX;
+    }
+    return bucketLowerBound(index + 1) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    counts_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t currentMax = max_.load(std::memory_order_relaxed);
+    while (value > currentMax &&
+           !max_.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        result.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        result.count += result.counts[i];
+    }
+    // count is summed from the buckets so quantiles stay consistent with it
+    // even while the owner keeps recording.
+    result.sum = sum_.load(std::memory_order_relaxed);
+    result.max = max_.load(std::memory_order_relaxed);
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : counts_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    max = std::max(max, other.max);
+}
+
+uint64_t LatencyHistogram::Snapshot::quantile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * count)));
+    if (rank >= count) {
+        return max;  // the top sample is known exactly
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t low = bucketLowerBound(i);
+            uint64_t high = bucketUpperBound(i);
+            uint64_t mid = low + (high - low) / 2;
+            return std::min(mid, max);
+        }
+    }
+    return max;
+}
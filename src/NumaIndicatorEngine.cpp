@@ -0,0 +1,119 @@
+#include "../include/NumaIndicatorEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+NumaIndicatorEngine::NumaIndicatorEngine(NumaTopology topology)
+    : topology_(std::move(topology)) {
+    if (topology_.size() == 0) {
+        topology_ = NumaTopology::singleNode(NumaTopology::allowedCpus());
+    }
+    for (const auto& node : topology_.nodes()) {
+        NodeStats stats;
+        stats.node = node.id;
+        stats.cpus = node.cpus.size();
+        stats_.push_back(stats);
+    }
+    partitions_.resize(topology_.size());
+}
+
+// body(k) runs once per node, on a thread pinned to node k with an OpenMP
+// team as wide as the node. A single node runs inline on the caller.
+template<typename Body>
+void NumaIndicatorEngine::runOnNodes(Body body) {
+    if (!topology_.isMultiNode()) {
+        body(0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(topology_.size());
+    for (size_t k = 0; k < topology_.size(); ++k) {
+        threads.emplace_back([this, k, &body] {
+            const auto& cpus = topology_.nodes()[k].cpus;
+            stats_[k].pinned = NumaTopology::pinCurrentThread(cpus);
+            #ifdef _OPENMP
+            omp_set_num_threads(static_cast<int>(cpus.size()));
+            #endif
+            body(k);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void NumaIndicatorEngine::load(const std::vector<TechnicalIndicator::StockData>& stocks) {
+    size_ = stocks.size();
+
+    // Contiguous split by price count, weighted by each node's CPUs
+    size_t totalCost = 0;
+    for (const auto& stock : stocks) {
+        totalCost += stock.prices.size() + 1;
+    }
+    const size_t totalCpus = std::max<size_t>(1, topology_.cpuCount());
+    std::vector<size_t> bounds(topology_.size() + 1, 0);
+    size_t cpusBefore = 0;
+    size_t next = 0, cost = 0;
+    for (size_t k = 0; k < topology_.size(); ++k) {
+        cpusBefore += topology_.nodes()[k].cpus.size();
+        size_t target = k + 1 == topology_.size() ? totalCost : totalCost * cpusBefore / totalCpus;
+        while (next < stocks.size() && cost < target) {
+            cost += stocks[next].prices.size() + 1;
+            ++next;
+        }
+        bounds[k + 1] = k + 1 == topology_.size() ? stocks.size() : next;
+    }
+
+    runOnNodes([&](size_t k) {
+        // Built from scratch on the node so its pages are first touched here
+        Partition partition;
+        partition.first = bounds[k];
+        size_t prices = 0;
+        for (size_t i = bounds[k]; i < bounds[k + 1]; ++i) {
+            prices += stocks[i].prices.size();
+        }
+        partition.store.reserve(bounds[k + 1] - bounds[k], prices);
+        for (size_t i = bounds[k]; i < bounds[k + 1]; ++i) {
+            partition.store.addSeries(stocks[i].symbol, stocks[i].prices.data(),
+                                      stocks[i].prices.size(), stocks[i].symbolId);
+        }
+        partition.results.resize(partition.store.size());
+        partitions_[k] = std::move(partition);
+
+        stats_[k].symbols = partitions_[k].store.size();
+        stats_[k].bars = prices;
+        stats_[k].seconds = 0.0;
+    });
+}
+
+std::vector<TechnicalIndicator::IndicatorResult> NumaIndicatorEngine::compute() {
+    runOnNodes([this](size_t k) {
+        auto start = std::chrono::steady_clock::now();
+        Partition& partition = partitions_[k];
+        const ColumnarPriceStore& store = partition.store;
+        const long count = static_cast<long>(store.size());
+
+        #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 16)
+        #endif
+        for (long i = 0; i < count; ++i) {
+            TechnicalIndicator::PriceSeriesView view{store.symbol(i), store.prices(i), nullptr,
+                                                     nullptr, store.length(i), store.symbolId(i)};
+            partition.results[i] = indicator_.computeIndicators(view);
+        }
+
+        stats_[k].seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    });
+
+    std::vector<TechnicalIndicator::IndicatorResult> results(size_);
+    for (const Partition& partition : partitions_) {
+        std::copy(partition.results.begin(), partition.results.end(),
+                  results.begin() + partition.first);
+    }
+    return results;
+}
@@ -0,0 +1,154 @@
+#include "../include/NumaTopology.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+NumaTopology NumaTopology::detect() {
+    return fromSysfs(kSysfsNodeRoot).restrictedTo(allowedCpus());
+}
+
+NumaTopology NumaTopology::fromSysfs(const std::string& root) {
+    std::vector<Node> nodes;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(root, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+            !std::all_of(name.begin() + 4, name.end(),
+                         [](unsigned char c) { return std::isdigit(c); })) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list)) {
+            continue;
+        }
+        // Memory-only nodes have an empty list and are dropped later. A list
+        // that does not parse leaves that node's CPUs unknown, so the tree
+        // is not trusted at all and callers fall back to a single node.
+        try {
+            nodes.push_back({std::stoi(name.substr(4)), parseCpuList(list)});
+        } catch (const std::logic_error&) {
+            return NumaTopology();
+        }
+    }
+    return fromNodes(std::move(nodes));
+}
+
+NumaTopology NumaTopology::singleNode(std::vector<int> cpus) {
+    return fromNodes({{0, std::move(cpus)}});
+}
+
+NumaTopology NumaTopology::fromNodes(std::vector<Node> nodes) {
+    std::sort(nodes.begin(), nodes.end(),
+              [](const Node& a, const Node& b) { return a.id < b.id; });
+    NumaTopology topology;
+    topology.nodes_ = std::move(nodes);
+    return topology;
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    auto number = [&]() {
+        size_t start = pos;
+        while (pos < list.size() && std::isdigit(static_cast<unsigned char>(list[pos]))) {
+            ++pos;
+        }
+        if (start == pos) {
+            throw std::invalid_argument("NumaTopology: malformed cpu list '" + list + "'");
+        }
+        return std::stoi(list.substr(start, pos - start));
+    };
+
+    while (pos < list.size() && !std::isspace(static_cast<unsigned char>(list[pos]))) {
+        int first = number();
+        int last = first;
+        if (pos < list.size() && list[pos] == '-') {
+            ++pos;
+            last = number();
+        }
+        if (last < first) {
+            throw std::invalid_argument("NumaTopology: malformed cpu list '" + list + "'");
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        if (pos < list.size() && list[pos] == ',') {
+            ++pos;
+        }
+    }
+    return cpus;
+}
+
+std::vector<int> NumaTopology::allowedCpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < count; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+bool NumaTopology::pinCurrentThread(const std::vector<int>& cpus) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 &&
+           pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+NumaTopology NumaTopology::restrictedTo(const std::vector<int>& allowed) const {
+    std::vector<Node> nodes;
+    for (const Node& node : nodes_) {
+        Node kept{node.id, {}};
+        for (int cpu : node.cpus) {
+            if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                kept.cpus.push_back(cpu);
+            }
+        }
+        if (!kept.cpus.empty()) {
+            nodes.push_back(std::move(kept));
+        }
+    }
+    if (nodes.empty()) {
+        return singleNode(allowed);
+    }
+    return fromNodes(std::move(nodes));
+}
+
+size_t NumaTopology::cpuCount() const {
+    size_t count = 0;
+    for (const Node& node : nodes_) {
+        count += node.cpus.size();
+    }
+    return count;
+}
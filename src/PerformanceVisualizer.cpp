@@ -104,21 +104,23 @@ void PerformanceVisualizer::plotExecutionTime(double sequentialTime, double para
 }
 
 void PerformanceVisualizer::plotScalability(const std::vector<int>& stockCounts,
-                                           const std::vector<double>& speedups) {
+                                           const std::vector<double>& speedups,
+                                           const std::string& label) {
     if (stockCounts.size() != speedups.size() || stockCounts.empty()) {
         return;
     }
     
     std::cout << "\n=== Scalability Analysis ===\n";
-    std::cout << "Speedup vs Number of Stocks\n\n";
+    std::cout << "Speedup vs Number of " << label << "\n\n";
     
     double maxSpeedup = *std::max_element(speedups.begin(), speedups.end());
+    int width = std::max<int>(6, label.size());
     
-    std::cout << "Stocks | Speedup\n";
-    std::cout << "-------|--------\n";
+    std::cout << std::setw(width) << std::left << label << std::right << " | Speedup\n";
+    std::cout << std::string(width + 1, '-') << "|--------\n";
     
     for (size_t i = 0; i < stockCounts.size(); ++i) {
-        std::cout << std::setw(6) << stockCounts[i] << " | ";
+        std::cout << std::setw(width) << stockCounts[i] << " | ";
         int barLength = static_cast<int>((speedups[i] / maxSpeedup) * 40);
         std::cout << std::string(barLength, '#') << " " 
                   << std::fixed << std::setprecision(2) << speedups[i] << "x\n";
@@ -1,11 +1,112 @@
 #include "../include/Scheduler.h"
 #include "../include/StockDataFetcher.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/ScratchArena.h"
 #include <iostream>
 #include <chrono>
 #include <random>
+#include <numeric>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
-Scheduler::Scheduler(int intervalSeconds)
-    : intervalSeconds_(intervalSeconds), running_(false), shouldStop_(false) {
+namespace {
+
+constexpr size_t kDispatchBatch = 64;
+constexpr size_t kIngestBatch = 64;
+// Consumers block on their queue; stop() wakes them, so this only bounds
+// how long a missed wakeup could go unnoticed.
+constexpr std::chrono::seconds kIdleTimeout(1);
+
+using Clock = std::chrono::steady_clock;
+
+struct HistogramEntry {
+    const char* name;
+    const char* help;
+    LatencyHistogram::Snapshot snapshot;
+    double scale;  // multiplies raw samples into the reported unit
+};
+
+struct CounterEntry {
+    const char* name;
+    const char* help;
+    const char* type;
+    double value;
+};
+
+constexpr double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+void writePrometheus(std::ostream& out, const std::vector<HistogramEntry>& histograms,
+                     const std::vector<CounterEntry>& counters) {
+    for (const auto& h : histograms) {
+        out << "# HELP " << h.name << " " << h.help << "\n"
+            << "# TYPE " << h.name << " summary\n";
+        for (double q : kQuantiles) {
+            out << h.name << "{quantile=\"" << q << "\"} " << h.snapshot.quantile(q) * h.scale << "\n";
+        }
+        out << h.name << "_sum " << h.snapshot.sum * h.scale << "\n"
+            << h.name << "_count " << h.snapshot.count << "\n"
+            << "# TYPE " << h.name << "_max gauge\n"
+            << h.name << "_max " << h.snapshot.max * h.scale << "\n";
+    }
+    for (const auto& c : counters) {
+        out << "# HELP " << c.name << " " << c.help << "\n"
+            << "# TYPE " << c.name << " " << c.type << "\n"
+            << c.name << " " << c.value << "\n";
+    }
+}
+
+void writeJson(std::ostream& out, const std::vector<HistogramEntry>& histograms,
+               const std::vector<CounterEntry>& counters) {
+    out << "{\n  \"histograms\": {\n";
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        const auto& h = histograms[i];
+        out << "    \"" << h.name << "\": {\"count\": " << h.snapshot.count
+            << ", \"sum\": " << h.snapshot.sum * h.scale
+            << ", \"mean\": " << h.snapshot.mean() * h.scale
+            << ", \"max\": " << h.snapshot.max * h.scale;
+        for (double q : kQuantiles) {
+            out << ", \"p" << q * 100 << "\": " << h.snapshot.quantile(q) * h.scale;
+        }
+        out << "}" << (i + 1 < histograms.size() ? "," : "") << "\n";
+    }
+    out << "  },\n  \"counters\": {\n";
+    for (size_t i = 0; i < counters.size(); ++i) {
+        out << "    \"" << counters[i].name << "\": " << counters[i].value
+            << (i + 1 < counters.size() ? "," : "") << "\n";
+    }
+    out << "  }\n}\n";
+}
+
+}
+
+template<typename T>
+std::unique_ptr<ConcurrentQueue<T>> Scheduler::makeQueue(QueueKind kind, size_t capacity,
+                                                         LatencyHistogram& waits) {
+    using Stamped = typename TimestampedQueue<T>::Stamped;
+    std::unique_ptr<ConcurrentQueue<Stamped>> inner;
+    switch (kind) {
+        case QueueKind::Spsc: inner = std::make_unique<SpscRingQueue<Stamped>>(capacity); break;
+        case QueueKind::Mpmc: inner = std::make_unique<MpmcRingQueue<Stamped>>(capacity); break;
+        case QueueKind::Locking: inner = std::make_unique<ThreadSafeQueue<Stamped>>(); break;
+    }
+    return std::make_unique<TimestampedQueue<T>>(std::move(inner), waits);
+}
+
+Scheduler::Scheduler(int intervalSeconds, QueueKind queueKind, size_t queueCapacity)
+    : Scheduler(std::chrono::seconds(intervalSeconds), queueKind, queueCapacity) {
+}
+
+Scheduler::Scheduler(std::chrono::nanoseconds interval, QueueKind queueKind, size_t queueCapacity)
+    : interval_(interval), running_(false), shouldStop_(false),
+      dataQueue_(makeQueue<TechnicalIndicator::StockData>(queueKind, queueCapacity,
+                                                          metrics_.ingestWait)),
+      notificationQueue_(makeQueue<TechnicalIndicator::IndicatorResult>(
+          queueKind, queueCapacity, metrics_.dispatchWait)),
+      cache_(std::make_shared<const CacheSnapshot>(
+          CacheSnapshot{0, {}, {}, std::make_shared<const std::unordered_map<std::string, size_t>>()})) {
 }
 
 Scheduler::~Scheduler() {
@@ -19,12 +120,41 @@ void Scheduler::start() {
 
     running_ = true;
     shouldStop_ = false;
+    dataQueue_->reset();
+    notificationQueue_->reset();
+    cycleTimers_.reset();
+    fetchTimers_.reset();
+    metricsTimers_.reset();
+    updatesReceived_ = 0;
+    batchesDrained_ = 0;
+    symbolsChanged_ = 0;
+    peakQueueDepth_ = 0;
+    startTime_ = std::chrono::steady_clock::now();
+    for (LatencyHistogram* histogram : {&metrics_.fetch, &metrics_.ingestWait,
+                                        &metrics_.ingestIdle, &metrics_.cachePublish,
+                                        &metrics_.dataQueueDepth, &metrics_.ingestCompute,
+                                        &metrics_.cycleCompute, &metrics_.dispatchWait,
+                                        &metrics_.dispatchIdle, &metrics_.dispatch}) {
+        histogram->reset();
+    }
+    metrics_.fetchRounds = 0;
+    metrics_.symbolsFetched = 0;
+    metrics_.cycles = 0;
+    metrics_.notificationsDispatched = 0;
+    metrics_.signalsRaised = 0;
+    metrics_.symbolsAnalyzed = 0;
+    metrics_.resultsUnchanged = 0;
     
     schedulerThread_ = std::thread(&Scheduler::schedulerThread, this);
     dataFetcherThread_ = std::thread(&Scheduler::dataFetcherThread, this);
     notificationDispatcherThread_ = std::thread(&Scheduler::notificationDispatcherThread, this);
+    ingestThread_ = std::thread(&Scheduler::ingestThread, this);
+    if (!metricsPath_.empty()) {
+        metricsThread_ = std::thread(&Scheduler::metricsThread, this);
+    }
     
-    std::cout << "[Scheduler] Started with interval: " << intervalSeconds_ << " seconds\n";
+    std::cout << "[Scheduler] Started with interval: "
+              << std::chrono::duration<double>(interval_).count() << " seconds\n";
 }
 
 void Scheduler::stop() {
@@ -35,8 +165,11 @@ void Scheduler::stop() {
     shouldStop_ = true;
     running_ = false;
     
-    dataQueue_.stop();
-    notificationQueue_.stop();
+    dataQueue_->stop();
+    notificationQueue_->stop();
+    cycleTimers_.stop();
+    fetchTimers_.stop();
+    metricsTimers_.stop();
     
     if (schedulerThread_.joinable()) {
         schedulerThread_.join();
@@ -47,6 +180,12 @@ void Scheduler::stop() {
     if (notificationDispatcherThread_.joinable()) {
         notificationDispatcherThread_.join();
     }
+    if (ingestThread_.joinable()) {
+        ingestThread_.join();
+    }
+    if (metricsThread_.joinable()) {
+        metricsThread_.join();
+    }
     
     std::cout << "[Scheduler] Stopped\n";
 }
@@ -59,37 +198,396 @@ void Scheduler::setNotificationCallback(NotificationCallback callback) {
     notificationCallback_ = callback;
 }
 
+void Scheduler::setRetention(size_t bars) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    retentionBars_ = bars > 0 ? std::max(bars, kMinRetentionBars) : 0;
+}
+
 void Scheduler::addStockData(const TechnicalIndicator::StockData& stockData) {
+    TechnicalIndicator::StockData update(stockData);
+    publishUpdates(&update, 1, nullptr);
+}
+
+void Scheduler::addStockData(const std::vector<TechnicalIndicator::StockData>& stocks) {
+    std::vector<TechnicalIndicator::StockData> updates(stocks);
+    publishUpdates(updates.data(), updates.size(), nullptr);
+}
+
+std::shared_ptr<const Scheduler::CacheSnapshot> Scheduler::snapshot() const {
+    return std::atomic_load(&cache_);
+}
+
+std::vector<TechnicalIndicator::IndicatorResult> Scheduler::latestResults() const {
+    std::lock_guard<std::mutex> lock(resultsMutex_);
+    std::vector<TechnicalIndicator::IndicatorResult> results;
+    results.reserve(latestResults_.size());
+    for (const auto& entry : latestResults_) {
+        results.push_back(entry.second);
+    }
+    return results;
+}
+
+const TechnicalIndicator::StockData* Scheduler::CacheSnapshot::find(
+    const std::string& symbol) const {
+    auto found = index->find(symbol);
+    return found != index->end() ? series[found->second].get() : nullptr;
+}
+
+std::vector<TechnicalIndicator::PriceSeriesView> Scheduler::CacheSnapshot::views() const {
+    std::vector<TechnicalIndicator::PriceSeriesView> result;
+    result.reserve(series.size());
+    for (const auto& stock : series) {
+        result.push_back(TechnicalIndicator::makeView(*stock));
+    }
+    return result;
+}
+
+Scheduler::StreamStats Scheduler::streamStats() const {
+    StreamStats stats;
+    stats.updatesReceived = updatesReceived_.load(std::memory_order_relaxed);
+    stats.batchesDrained = batchesDrained_.load(std::memory_order_relaxed);
+    stats.symbolsChanged = symbolsChanged_.load(std::memory_order_relaxed);
+    stats.queueDepth = dataQueue_->size();
+    stats.peakQueueDepth = std::max(peakQueueDepth_.load(std::memory_order_relaxed),
+                                    stats.queueDepth);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime_).count();
+    if (running_ && elapsed > 0) {
+        stats.updatesPerSecond = stats.updatesReceived / elapsed;
+    }
+    return stats;
+}
+
+std::shared_ptr<const Scheduler::CacheSnapshot> Scheduler::publishUpdates(
+    TechnicalIndicator::StockData* updates, size_t count, std::vector<size_t>* changed) {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    stockDataCache_.push_back(stockData);
+    std::shared_ptr<const CacheSnapshot> current = std::atomic_load(&cache_);
+    
+    // Copying the snapshot copies only pointers; each series is deep-copied
+    // only when an update actually changes it.
+    auto next = std::make_shared<CacheSnapshot>(*current);
+    next->version = current->version + 1;
+    std::unordered_map<std::string, size_t>* grownIndex = nullptr;
+    bool modified = false;
+    if (changed) {
+        changed->clear();
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        TechnicalIndicator::StockData& update = updates[i];
+        const auto& index = grownIndex ? *grownIndex : *next->index;
+        auto found = index.find(update.symbol);
+        size_t position;
+        if (found == index.end()) {
+            if (!grownIndex) {
+                auto copy = std::make_shared<std::unordered_map<std::string, size_t>>(*next->index);
+                grownIndex = copy.get();
+                next->index = std::move(copy);
+            }
+            position = next->series.size();
+            grownIndex->emplace(update.symbol, position);
+            if (update.symbolId == SymbolTable::kInvalidId) {
+                update.symbolId = SymbolTable::global().intern(update.symbol);
+            }
+            next->series.push_back(retainTail(std::move(update), retentionBars_));
+            next->versions.push_back(next->version);
+        } else {
+            position = found->second;
+            auto merged = mergeSeries(*next->series[position], std::move(update), retentionBars_);
+            if (!merged) {
+                continue;
+            }
+            next->series[position] = std::move(merged);
+            next->versions[position] = next->version;
+        }
+        modified = true;
+        if (changed) {
+            changed->push_back(position);
+        }
+        if (position >= dirtyFlags_.size()) {
+            dirtyFlags_.resize(position + 1, 0);
+        }
+        if (!dirtyFlags_[position]) {
+            dirtyFlags_[position] = 1;
+            dirty_.push_back(position);
+        }
+    }
+    
+    if (changed) {
+        std::sort(changed->begin(), changed->end());
+        changed->erase(std::unique(changed->begin(), changed->end()), changed->end());
+    }
+    if (!modified) {
+        return current;  // no-op updates do not churn versions
+    }
+    std::shared_ptr<const CacheSnapshot> published = std::move(next);
+    std::atomic_store(&cache_, published);
+    return published;
 }
 
-ThreadSafeQueue<TechnicalIndicator::IndicatorResult>& Scheduler::getNotificationQueue() {
-    return notificationQueue_;
+std::shared_ptr<const TechnicalIndicator::StockData> Scheduler::retainTail(
+    TechnicalIndicator::StockData&& stock, size_t retention) {
+    size_t length = stock.prices.size();
+    stock.volumes.resize(length);
+    size_t drop = retention > 0 && length > retention ? length - retention : 0;
+    if (drop > 0) {
+        stock.prices.erase(stock.prices.begin(), stock.prices.begin() + drop);
+        stock.volumes.erase(stock.volumes.begin(), stock.volumes.begin() + drop);
+        if (stock.timestamps.size() == length) {
+            stock.timestamps.erase(stock.timestamps.begin(), stock.timestamps.begin() + drop);
+        }
+    }
+    return std::make_shared<const TechnicalIndicator::StockData>(std::move(stock));
+}
+
+std::shared_ptr<const TechnicalIndicator::StockData> Scheduler::mergeSeries(
+    const TechnicalIndicator::StockData& cached, TechnicalIndicator::StockData&& update,
+    size_t retention) {
+    // Without timestamps there is nothing to align on: take the update whole.
+    if (update.timestamps.size() != update.prices.size() ||
+        cached.timestamps.size() != cached.prices.size()) {
+        if (cached.prices == update.prices) {
+            return nullptr;
+        }
+        update.symbolId = cached.symbolId;
+        return retainTail(std::move(update), retention);
+    }
+    if (update.prices.empty()) {
+        return nullptr;
+    }
+    
+    size_t keep = std::lower_bound(cached.timestamps.begin(), cached.timestamps.end(),
+                                   update.timestamps.front()) - cached.timestamps.begin();
+    bool changed = cached.prices.size() - keep != update.prices.size() ||
+                   !std::equal(update.prices.begin(), update.prices.end(),
+                               cached.prices.begin() + keep) ||
+                   !std::equal(update.timestamps.begin(), update.timestamps.end(),
+                               cached.timestamps.begin() + keep);
+    if (!changed) {
+        return nullptr;
+    }
+    
+    // Copy only the bars that survive retention: the tail of cached[0, keep)
+    // followed by the tail of the update. Cached volumes are always full
+    // length (retainTail pads them).
+    update.volumes.resize(update.prices.size());
+    size_t total = keep + update.prices.size();
+    size_t drop = retention > 0 && total > retention ? total - retention : 0;
+    size_t cachedFrom = std::min(drop, keep);
+    size_t updateFrom = drop - cachedFrom;
+    
+    auto merged = std::make_shared<TechnicalIndicator::StockData>();
+    merged->symbol = cached.symbol;
+    merged->symbolId = cached.symbolId;
+    auto splice = [&](std::vector<double>& out, const std::vector<double>& head,
+                      const std::vector<double>& tail) {
+        out.reserve(total - drop);
+        out.assign(head.begin() + cachedFrom, head.begin() + keep);
+        out.insert(out.end(), tail.begin() + updateFrom, tail.end());
+    };
+    splice(merged->prices, cached.prices, update.prices);
+    splice(merged->volumes, cached.volumes, update.volumes);
+    splice(merged->timestamps, cached.timestamps, update.timestamps);
+    return merged;
+}
+
+void Scheduler::setMetricsDump(const std::string& path, int intervalSeconds,
+                               MetricsFormat format) {
+    metricsPath_ = path;
+    metricsIntervalSeconds_ = std::max(1, intervalSeconds);
+    metricsFormat_ = format;
+}
+
+std::string Scheduler::metricsReport(MetricsFormat format) const {
+    const double ns = 1e-9;
+    std::vector<HistogramEntry> histograms = {
+        {"scheduler_fetch_seconds", "Time to fetch one round of symbols",
+         metrics_.fetch.snapshot(), ns},
+        {"scheduler_ingest_wait_seconds", "Time updates waited in the data queue",
+         metrics_.ingestWait.snapshot(), ns},
+        {"scheduler_ingest_idle_seconds", "Ingest idle time until updates arrived",
+         metrics_.ingestIdle.snapshot(), ns},
+        {"scheduler_cache_publish_seconds", "Ingest time to merge and publish a cache version",
+         metrics_.cachePublish.snapshot(), ns},
+        {"scheduler_data_queue_depth", "Data queue depth sampled before each drain",
+         metrics_.dataQueueDepth.snapshot(), 1.0},
+        {"scheduler_ingest_compute_seconds", "Recompute time for changed symbols",
+         metrics_.ingestCompute.snapshot(), ns},
+        {"scheduler_cycle_compute_seconds", "Compute time of one periodic analysis cycle",
+         metrics_.cycleCompute.snapshot(), ns},
+        {"scheduler_dispatch_wait_seconds", "Time results waited in the notification queue",
+         metrics_.dispatchWait.snapshot(), ns},
+        {"scheduler_dispatch_idle_seconds", "Dispatcher idle time until results arrived",
+         metrics_.dispatchIdle.snapshot(), ns},
+        {"scheduler_dispatch_seconds", "Time to dispatch one batch of results",
+         metrics_.dispatch.snapshot(), ns},
+    };
+    
+    // All analysis, wherever it ran
+    HistogramEntry compute{"scheduler_compute_seconds", "Compute time of any analysis callback",
+                           metrics_.cycleCompute.snapshot(), ns};
+    compute.snapshot.merge(metrics_.ingestCompute.snapshot());
+    histograms.push_back(compute);
+    
+    StreamStats stream = streamStats();
+    std::shared_ptr<const CacheSnapshot> cache = snapshot();
+    std::vector<CounterEntry> counters = {
+        {"scheduler_fetch_rounds_total", "Fetch rounds completed", "counter",
+         static_cast<double>(metrics_.fetchRounds.load(std::memory_order_relaxed))},
+        {"scheduler_symbols_fetched_total", "Symbols fetched", "counter",
+         static_cast<double>(metrics_.symbolsFetched.load(std::memory_order_relaxed))},
+        {"scheduler_updates_received_total", "Updates drained from the data queue", "counter",
+         static_cast<double>(stream.updatesReceived)},
+        {"scheduler_symbols_recomputed_total", "Symbols recomputed after a change", "counter",
+         static_cast<double>(stream.symbolsChanged)},
+        {"scheduler_cycles_total", "Periodic analysis cycles", "counter",
+         static_cast<double>(metrics_.cycles.load(std::memory_order_relaxed))},
+        {"scheduler_notifications_total", "Results taken off the notification queue", "counter",
+         static_cast<double>(metrics_.notificationsDispatched.load(std::memory_order_relaxed))},
+        {"scheduler_signals_total", "BUY/SELL signals dispatched", "counter",
+         static_cast<double>(metrics_.signalsRaised.load(std::memory_order_relaxed))},
+        {"scheduler_symbols_analyzed_total", "Symbols analyzed by cycles, watchlists and ingest",
+         "counter", static_cast<double>(metrics_.symbolsAnalyzed.load(std::memory_order_relaxed))},
+        {"scheduler_results_unchanged_total", "Results dropped as identical to the previous one",
+         "counter", static_cast<double>(metrics_.resultsUnchanged.load(std::memory_order_relaxed))},
+        {"scheduler_data_queue_depth_current", "Current data queue depth", "gauge",
+         static_cast<double>(stream.queueDepth)},
+        {"scheduler_notification_queue_depth_current", "Current notification queue depth",
+         "gauge", static_cast<double>(notificationQueue_->size())},
+        {"scheduler_cache_version", "Cache versions published", "counter",
+         static_cast<double>(cache->version)},
+        {"scheduler_cache_symbols", "Symbols in the current cache version", "gauge",
+         static_cast<double>(cache->series.size())},
+    };
+    
+    std::ostringstream out;
+    out << std::setprecision(9);
+    if (format == MetricsFormat::Json) {
+        writeJson(out, histograms, counters);
+    } else {
+        writePrometheus(out, histograms, counters);
+    }
+    return out.str();
+}
+
+bool Scheduler::writeMetrics(const std::string& path, MetricsFormat format) const {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary);
+        if (!out) {
+            return false;
+        }
+        out << metricsReport(format);
+        if (!out.flush()) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+void Scheduler::metricsThread() {
+    auto dump = metricsTimers_.schedule(std::chrono::seconds(metricsIntervalSeconds_), [this] {
+        if (!writeMetrics(metricsPath_, metricsFormat_)) {
+            std::cerr << "[Metrics] Cannot write " << metricsPath_ << "\n";
+        }
+    });
+    metricsTimers_.run();
+    metricsTimers_.cancel(dump);
+    writeMetrics(metricsPath_, metricsFormat_);
+}
+
+TimerQueue::TimerId Scheduler::addWatchlist(const std::vector<std::string>& symbols,
+                                            std::chrono::nanoseconds interval) {
+    return cycleTimers_.schedule(interval, [this, symbols] { analyzeWatchlist(symbols); });
+}
+
+bool Scheduler::removeWatchlist(TimerQueue::TimerId id) {
+    return cycleTimers_.cancel(id);
+}
+
+ConcurrentQueue<TechnicalIndicator::IndicatorResult>& Scheduler::getNotificationQueue() {
+    return *notificationQueue_;
 }
 
 void Scheduler::schedulerThread() {
     std::cout << "[Scheduler] Thread started\n";
     
-    while (!shouldStop_) {
-        auto startTime = std::chrono::steady_clock::now();
-        
-        {
-            std::lock_guard<std::mutex> lock(cacheMutex_);
-            if (!stockDataCache_.empty() && analysisCallback_) {
-                std::cout << "[Scheduler] Triggering analysis cycle for " 
-                          << stockDataCache_.size() << " stocks\n";
-                analysisCallback_(stockDataCache_);
-            }
+    // First cycle immediately, then at a fixed rate of interval_
+    auto cycle = cycleTimers_.scheduleAt(Clock::now(), interval_, [this] { runAnalysisCycle(); });
+    cycleTimers_.run();
+    cycleTimers_.cancel(cycle);
+    
+    std::cout << "[Scheduler] Thread stopped\n";
+}
+
+void Scheduler::runAnalysisCycle() {
+    if (!analysisCallback_) {
+        return;  // leave the dirty set for when a callback is installed
+    }
+    
+    // Take the dirty set and the snapshot together, so every index taken
+    // has its change in the snapshot. Writers wait only for this swap,
+    // never for the analysis itself, and get back last cycle's buffer.
+    std::vector<size_t>& dirty = cycleDirty_;
+    dirty.clear();
+    std::shared_ptr<const CacheSnapshot> cache;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        dirty.swap(dirty_);
+        for (size_t index : dirty) {
+            dirtyFlags_[index] = 0;
         }
-        
-        auto targetTime = startTime + std::chrono::seconds(intervalSeconds_);
-        while (std::chrono::steady_clock::now() < targetTime && !shouldStop_) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        cache = std::atomic_load(&cache_);
+    }
+    std::sort(dirty.begin(), dirty.end());
+    
+    size_t analyzed = analyzeStale(*cache, dirty, metrics_.cycleCompute);
+    metrics_.cycles.fetch_add(1, std::memory_order_relaxed);
+    std::cout << "[Scheduler] Analysis cycle at cache version " << cache->version << ": "
+              << analyzed << " of " << cache->series.size() << " stocks changed\n";
+}
+
+void Scheduler::analyzeWatchlist(const std::vector<std::string>& symbols) {
+    if (!analysisCallback_) {
+        return;
+    }
+    std::shared_ptr<const CacheSnapshot> cache = snapshot();
+    std::vector<size_t> selected;
+    for (const auto& symbol : symbols) {
+        auto found = cache->index->find(symbol);
+        if (found != cache->index->end()) {
+            selected.push_back(found->second);
         }
     }
+    analyzeStale(*cache, selected, metrics_.cycleCompute);
+}
+
+size_t Scheduler::analyzeStale(const CacheSnapshot& cache, const std::vector<size_t>& candidates,
+                               LatencyHistogram& computeHistogram) {
+    std::lock_guard<std::mutex> analysisLock(analysisMutex_);
+    if (analyzedVersions_.size() < cache.series.size()) {
+        analyzedVersions_.resize(cache.series.size(), 0);
+    }
     
-    std::cout << "[Scheduler] Thread stopped\n";
+    // Scratch the callback takes from this thread's arena lives until the
+    // analysis is done
+    ScratchArena::Scope scratch;
+    std::vector<TechnicalIndicator::PriceSeriesView>& stale = staleViews_;
+    stale.clear();
+    for (size_t index : candidates) {
+        if (cache.versions[index] > analyzedVersions_[index]) {
+            analyzedVersions_[index] = cache.versions[index];
+            stale.push_back(TechnicalIndicator::makeView(*cache.series[index]));
+        }
+    }
+    
+    if (!stale.empty()) {
+        auto computeStart = Clock::now();
+        analysisCallback_(stale);
+        computeHistogram.record(Clock::now() - computeStart);
+        metrics_.symbolsAnalyzed.fetch_add(stale.size(), std::memory_order_relaxed);
+    }
+    return stale.size();
 }
 
 void Scheduler::dataFetcherThread() {
@@ -101,41 +599,126 @@ void Scheduler::dataFetcherThread() {
     std::vector<std::string> symbols = {"IBM", "AAPL", "GOOGL", "MSFT", "AMZN", 
                                         "TSLA", "META", "NVDA", "JPM", "V"};
     
+    auto round = fetchTimers_.schedule(fetchInterval_, [this, &fetcher, &symbols] {
+        fetchRound(fetcher, symbols);
+    });
+    fetchTimers_.run();
+    fetchTimers_.cancel(round);
+    
+    std::cout << "[DataFetcher] Thread stopped\n";
+}
+
+void Scheduler::fetchRound(StockDataFetcher& fetcher, const std::vector<std::string>& symbols) {
+    auto fetchStart = Clock::now();
+    std::vector<TechnicalIndicator::StockData> batch(symbols.size());
+    if (workerPool_) {
+        std::vector<size_t> bounds(symbols.size() + 1);
+        std::iota(bounds.begin(), bounds.end(), 0);
+        workerPool_->parallelFor(bounds, [&fetcher, &symbols, &batch](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                batch[i] = fetcher.fetchStockData(symbols[i]);
+            }
+        });
+    } else {
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            batch[i] = fetcher.fetchStockData(symbols[i]);
+        }
+    }
+    metrics_.fetch.record(Clock::now() - fetchStart);
+    metrics_.fetchRounds.fetch_add(1, std::memory_order_relaxed);
+    metrics_.symbolsFetched.fetch_add(batch.size(), std::memory_order_relaxed);
+    dataQueue_->pushBulkMove(batch.data(), batch.size());
+}
+
+void Scheduler::ingestThread() {
+    std::cout << "[Ingest] Thread started\n";
+    
+    std::vector<TechnicalIndicator::StockData> batch(kIngestBatch);
+    std::vector<size_t> touched;
+    auto idleStart = Clock::now();
+    
     while (!shouldStop_) {
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        size_t depth = dataQueue_->size();
+        if (depth > peakQueueDepth_.load(std::memory_order_relaxed)) {
+            peakQueueDepth_.store(depth, std::memory_order_relaxed);
+        }
+        
+        size_t count = dataQueue_->waitPopBulk(batch.data(), batch.size(), kIdleTimeout);
+        if (count == 0) {
+            continue;
+        }
+        auto popped = Clock::now();
+        metrics_.ingestIdle.record(popped - idleStart);
+        metrics_.dataQueueDepth.record(depth);
         
-        if (shouldStop_) break;
+        // Publish the whole batch as one cache version, then analyze only
+        // the symbols whose series actually moved. Only another writer can
+        // delay the publish; a running analysis cycle cannot.
+        std::shared_ptr<const CacheSnapshot> cache = publishUpdates(batch.data(), count, &touched);
+        metrics_.cachePublish.record(Clock::now() - popped);
         
-        for (const auto& symbol : symbols) {
-            TechnicalIndicator::StockData stockData = fetcher.fetchStockData(symbol);
-            dataQueue_.push(stockData);
+        updatesReceived_.fetch_add(count, std::memory_order_relaxed);
+        batchesDrained_.fetch_add(1, std::memory_order_relaxed);
+        symbolsChanged_.fetch_add(touched.size(), std::memory_order_relaxed);
+        
+        if (analysisCallback_) {
+            analyzeStale(*cache, touched, metrics_.ingestCompute);
         }
+        idleStart = Clock::now();
     }
     
-    std::cout << "[DataFetcher] Thread stopped\n";
+    std::cout << "[Ingest] Thread stopped\n";
 }
 
 void Scheduler::notificationDispatcherThread() {
     std::cout << "[NotificationDispatcher] Thread started\n";
     
+    std::vector<TechnicalIndicator::IndicatorResult> batch(kDispatchBatch);
+    auto idleStart = Clock::now();
+    
     while (!shouldStop_) {
-        auto result = notificationQueue_.tryPop();
+        size_t count = notificationQueue_->waitPopBulk(batch.data(), batch.size(),
+                                                       kIdleTimeout);
+        if (count == 0) {
+            continue;
+        }
+        auto dispatchStart = Clock::now();
+        metrics_.dispatchIdle.record(dispatchStart - idleStart);
         
-        if (result.has_value()) {
-            TechnicalIndicator::IndicatorResult notification = result.value();
+        uint64_t signals = 0;
+        uint64_t unchanged = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const TechnicalIndicator::IndicatorResult& notification = batch[i];
+            {
+                std::lock_guard<std::mutex> lock(resultsMutex_);
+                auto inserted = latestResults_.emplace(notification.symbolId, notification);
+                if (!inserted.second) {
+                    if (inserted.first->second == notification) {
+                        ++unchanged;
+                        continue;
+                    }
+                    inserted.first->second = notification;
+                }
+            }
             
-            if (notification.signal == "BUY" || notification.signal == "SELL") {
-                std::cout << "[NotificationDispatcher] Signal: " << notification.signal 
-                          << " for " << notification.symbol 
+            if (notification.signal != TechnicalIndicator::Signal::Hold) {
+                std::cout << "[NotificationDispatcher] Signal: "
+                          << TechnicalIndicator::signalName(notification.signal)
+                          << " for " << TechnicalIndicator::symbolName(notification)
                           << " (Strength: " << notification.signal_strength << ")\n";
                 
                 if (notificationCallback_) {
                     notificationCallback_(notification);
                 }
+                ++signals;
             }
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
+        
+        idleStart = Clock::now();
+        metrics_.dispatch.record(idleStart - dispatchStart);
+        metrics_.notificationsDispatched.fetch_add(count, std::memory_order_relaxed);
+        metrics_.signalsRaised.fetch_add(signals, std::memory_order_relaxed);
+        metrics_.resultsUnchanged.fetch_add(unchanged, std::memory_order_relaxed);
     }
     
     std::cout << "[NotificationDispatcher] Thread stopped\n";
@@ -0,0 +1,51 @@
+#include "../include/ScratchArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+ScratchArena& ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+ScratchArena::~ScratchArena() {
+    for (const Block& block : blocks_) {
+        ::operator delete(block.data, std::align_val_t(kCacheLineSize));
+    }
+}
+
+void* ScratchArena::allocate(size_t bytes, size_t alignment) {
+    // Try the current block, then blocks kept from before the last rewind
+    for (; current_ < blocks_.size(); ++current_, offset_ = 0) {
+        const Block& block = blocks_[current_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        size_t start = ((base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+        if (start + bytes <= block.size) {
+            offset_ = start + bytes;
+            return block.data + start;
+        }
+    }
+
+    size_t size = std::max(kBlockSize, bytes + alignment);
+    auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t(kCacheLineSize)));
+    blocks_.push_back({data, size});
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return allocate(bytes, alignment);
+}
+
+size_t ScratchArena::bytesUsed() const {
+    size_t used = 0;
+    for (size_t i = 0; i < current_ && i < blocks_.size(); ++i) {
+        used += blocks_[i].size;
+    }
+    return used + offset_;
+}
+
+size_t ScratchArena::capacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,195 @@
+#include "../include/SimdKernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Window positions (0 = oldest of the last kWindow prices) at which each
+// indicator starts reading, mirroring the scalar definitions.
+constexpr int kSma20Start = SimdKernels::kWindow - 20;
+constexpr int kRsiStart = SimdKernels::kWindow - 14 + 1;
+constexpr int kEma26Seed = SimdKernels::kWindow - 26;
+constexpr int kEma12Seed = SimdKernels::kWindow - 12;
+constexpr double kMultiplier12 = 2.0 / (12 + 1);
+constexpr double kMultiplier26 = 2.0 / (26 + 1);
+
+#ifdef SIMD_KERNELS_X86
+
+__attribute__((target("avx2")))
+void snapshotAvx2(const double* base, const int64_t* windowStart,
+                  double* sma20, double* sma50, double* rsi,
+                  double* macd, double* macdSignal) {
+    const __m256i start = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(windowStart));
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    const __m256d m12 = _mm256_set1_pd(kMultiplier12);
+    const __m256d m26 = _mm256_set1_pd(kMultiplier26);
+
+    __m256d sum20 = zero, sum50 = zero, gains = zero, losses = zero;
+    __m256d ema12 = zero, ema26 = zero, prev = zero;
+
+    for (int k = 0; k < SimdKernels::kWindow; ++k) {
+        __m256i index = _mm256_add_epi64(start, _mm256_set1_epi64x(k));
+        __m256d price = _mm256_i64gather_pd(base, index, 8);
+
+        sum50 = _mm256_add_pd(sum50, price);
+        if (k >= kSma20Start) sum20 = _mm256_add_pd(sum20, price);
+
+        if (k >= kRsiStart) {
+            __m256d change = _mm256_sub_pd(price, prev);
+            __m256d up = _mm256_cmp_pd(change, zero, _CMP_GT_OQ);
+            gains = _mm256_add_pd(gains, _mm256_and_pd(up, change));
+            losses = _mm256_add_pd(losses,
+                                   _mm256_andnot_pd(up, _mm256_xor_pd(change, signBit)));
+        }
+
+        if (k == kEma26Seed) ema26 = price;
+        else if (k > kEma26Seed)
+            ema26 = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(price, ema26), m26), ema26);
+
+        if (k == kEma12Seed) ema12 = price;
+        else if (k > kEma12Seed)
+            ema12 = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(price, ema12), m12), ema12);
+
+        prev = price;
+    }
+
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d rsiPeriod = _mm256_set1_pd(14.0);
+    __m256d avgGain = _mm256_div_pd(gains, rsiPeriod);
+    __m256d avgLoss = _mm256_div_pd(losses, rsiPeriod);
+    __m256d rs = _mm256_div_pd(avgGain, avgLoss);
+    __m256d rsiValue = _mm256_sub_pd(
+        hundred, _mm256_div_pd(hundred, _mm256_add_pd(_mm256_set1_pd(1.0), rs)));
+    __m256d noLoss = _mm256_cmp_pd(avgLoss, zero, _CMP_EQ_OQ);
+    rsiValue = _mm256_blendv_pd(rsiValue, hundred, noLoss);
+
+    __m256d macdValue = _mm256_sub_pd(ema12, ema26);
+
+    _mm256_storeu_pd(sma20, _mm256_div_pd(sum20, _mm256_set1_pd(20.0)));
+    _mm256_storeu_pd(sma50, _mm256_div_pd(sum50, _mm256_set1_pd(50.0)));
+    _mm256_storeu_pd(rsi, rsiValue);
+    _mm256_storeu_pd(macd, macdValue);
+    _mm256_storeu_pd(macdSignal, _mm256_mul_pd(macdValue, _mm256_set1_pd(0.9)));
+}
+
+__attribute__((target("avx512f")))
+void snapshotAvx512(const double* base, const int64_t* windowStart,
+                    double* sma20, double* sma50, double* rsi,
+                    double* macd, double* macdSignal) {
+    const __m512i start = _mm512_loadu_si512(windowStart);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512i signBit = _mm512_set1_epi64(static_cast<int64_t>(0x8000000000000000ULL));
+    const __m512d m12 = _mm512_set1_pd(kMultiplier12);
+    const __m512d m26 = _mm512_set1_pd(kMultiplier26);
+
+    __m512d sum20 = zero, sum50 = zero, gains = zero, losses = zero;
+    __m512d ema12 = zero, ema26 = zero, prev = zero;
+
+    for (int k = 0; k < SimdKernels::kWindow; ++k) {
+        __m512i index = _mm512_add_epi64(start, _mm512_set1_epi64(k));
+        __m512d price = _mm512_mask_i64gather_pd(zero, 0xFF, index, base, 8);
+
+        sum50 = _mm512_add_pd(sum50, price);
+        if (k >= kSma20Start) sum20 = _mm512_add_pd(sum20, price);
+
+        if (k >= kRsiStart) {
+            __m512d change = _mm512_sub_pd(price, prev);
+            __mmask8 up = _mm512_cmp_pd_mask(change, zero, _CMP_GT_OQ);
+            __m512d negated = _mm512_castsi512_pd(
+                _mm512_xor_si512(_mm512_castpd_si512(change), signBit));
+            gains = _mm512_add_pd(gains, _mm512_maskz_mov_pd(up, change));
+            losses = _mm512_add_pd(losses, _mm512_maskz_mov_pd(static_cast<__mmask8>(~up),
+                                                               negated));
+        }
+
+        if (k == kEma26Seed) ema26 = price;
+        else if (k > kEma26Seed)
+            ema26 = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(price, ema26), m26), ema26);
+
+        if (k == kEma12Seed) ema12 = price;
+        else if (k > kEma12Seed)
+            ema12 = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(price, ema12), m12), ema12);
+
+        prev = price;
+    }
+
+    const __m512d hundred = _mm512_set1_pd(100.0);
+    const __m512d rsiPeriod = _mm512_set1_pd(14.0);
+    __m512d avgGain = _mm512_div_pd(gains, rsiPeriod);
+    __m512d avgLoss = _mm512_div_pd(losses, rsiPeriod);
+    __m512d rs = _mm512_div_pd(avgGain, avgLoss);
+    __m512d rsiValue = _mm512_sub_pd(
+        hundred, _mm512_div_pd(hundred, _mm512_add_pd(_mm512_set1_pd(1.0), rs)));
+    __mmask8 noLoss = _mm512_cmp_pd_mask(avgLoss, zero, _CMP_EQ_OQ);
+    rsiValue = _mm512_mask_blend_pd(noLoss, rsiValue, hundred);
+
+    __m512d macdValue = _mm512_sub_pd(ema12, ema26);
+
+    _mm512_storeu_pd(sma20, _mm512_div_pd(sum20, _mm512_set1_pd(20.0)));
+    _mm512_storeu_pd(sma50, _mm512_div_pd(sum50, _mm512_set1_pd(50.0)));
+    _mm512_storeu_pd(rsi, rsiValue);
+    _mm512_storeu_pd(macd, macdValue);
+    _mm512_storeu_pd(macdSignal, _mm512_mul_pd(macdValue, _mm512_set1_pd(0.9)));
+}
+
+#endif
+
+}
+
+SimdKernels::Level SimdKernels::detectLevel() {
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+#endif
+    return Level::Scalar;
+}
+
+SimdKernels::Level SimdKernels::activeLevel() {
+    static const Level level = detectLevel();
+    return level;
+}
+
+bool SimdKernels::isSupported(Level level) {
+    return static_cast<int>(level) <= static_cast<int>(activeLevel());
+}
+
+size_t SimdKernels::laneWidth(Level level) {
+    switch (level) {
+        case Level::AVX2: return 4;
+        case Level::AVX512: return 8;
+        case Level::Scalar: break;
+    }
+    return 1;
+}
+
+const char* SimdKernels::levelName(Level level) {
+    switch (level) {
+        case Level::AVX2: return "AVX2";
+        case Level::AVX512: return "AVX-512";
+        case Level::Scalar: break;
+    }
+    return "scalar";
+}
+
+void SimdKernels::snapshotLanes(Level level, const double* base, const int64_t* windowStart,
+                                double* sma20, double* sma50, double* rsi,
+                                double* macd, double* macdSignal) {
+#ifdef SIMD_KERNELS_X86
+    if (level == Level::AVX512) {
+        snapshotAvx512(base, windowStart, sma20, sma50, rsi, macd, macdSignal);
+        return;
+    }
+    if (level == Level::AVX2) {
+        snapshotAvx2(base, windowStart, sma20, sma50, rsi, macd, macdSignal);
+        return;
+    }
+#else
+    (void)level; (void)base; (void)windowStart;
+    (void)sma20; (void)sma50; (void)rsi; (void)macd; (void)macdSignal;
+#endif
+}
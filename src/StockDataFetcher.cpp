@@ -1,6 +1,227 @@
 #include "../include/StockDataFetcher.h"
 #include <random>
 #include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Smallest chunk worth handing to a thread; below this the split overhead
+// outweighs the parallelism.
+constexpr size_t kMinChunkBytes = 1 << 20;
+constexpr int kChunksPerThread = 4;
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("mmap failed for " + path);
+            }
+            data_ = static_cast<const char*>(mapping);
+            ::madvise(mapping, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+struct ChunkSeries {
+    std::string_view symbol;
+    std::vector<double> prices;
+    std::vector<double> volumes;
+    std::vector<double> timestamps;
+};
+
+struct ChunkResult {
+    std::vector<ChunkSeries> series;
+    size_t rows = 0;
+    size_t skippedRows = 0;
+};
+
+std::string_view trimField(std::string_view field) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '"')) {
+        field.remove_prefix(1);
+    }
+    while (!field.empty() && (field.back() == ' ' || field.back() == '"')) {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+bool parseDouble(std::string_view field, double& value) {
+    field = trimField(field);
+    if (!field.empty() && field.front() == '+') {
+        field.remove_prefix(1);
+    }
+    const char* last = field.data() + field.size();
+    auto result = std::from_chars(field.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+bool parseInt(const char* first, const char* last, int& value) {
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+bool parseTimestamp(std::string_view field, double& value) {
+    field = trimField(field);
+    if (field.size() == 10 && field[4] == '-' && field[7] == '-') {
+        int year, month, day;
+        const char* p = field.data();
+        if (!parseInt(p, p + 4, year) || !parseInt(p + 5, p + 7, month) ||
+            !parseInt(p + 8, p + 10, day)) {
+            return false;
+        }
+        value = year * 10000.0 + month * 100.0 + day;
+        return true;
+    }
+    return parseDouble(field, value);
+}
+
+// The parser indexes a fixed field array by these positions, so they must
+// be non-negative and name four different columns.
+void validateLayout(const StockDataFetcher::CsvLayout& layout) {
+    const int columns[] = {layout.symbolColumn, layout.timestampColumn, layout.priceColumn,
+                           layout.volumeColumn};
+    for (size_t i = 0; i < 4; ++i) {
+        if (columns[i] < 0) {
+            throw std::invalid_argument("CSV column index must be non-negative");
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (columns[i] == columns[j]) {
+                throw std::invalid_argument("CSV layout uses column " +
+                                            std::to_string(columns[i]) + " twice");
+            }
+        }
+    }
+}
+
+// Parses every complete line in [begin, end). Symbols stay string_views
+// into the mapping; only the numeric columns are materialized.
+void parseChunk(const char* begin, const char* end, const StockDataFetcher::CsvLayout& layout,
+                bool mayStartWithHeader, ChunkResult& out) {
+    const int maxColumn = std::max({layout.symbolColumn, layout.timestampColumn,
+                                    layout.priceColumn, layout.volumeColumn});
+    std::vector<std::string_view> fields(maxColumn + 1);
+    std::unordered_map<std::string_view, size_t> index;
+
+    bool firstLine = mayStartWithHeader;
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        const char* lineEnd = newline ? newline : end;
+        const char* stop = (lineEnd > line && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+
+        if (stop > line) {
+            int columns = 0;
+            const char* field = line;
+            while (columns <= maxColumn) {
+                const char* delimiter = static_cast<const char*>(
+                    std::memchr(field, layout.delimiter, stop - field));
+                const char* fieldEnd = delimiter ? delimiter : stop;
+                fields[columns++] = std::string_view(field, fieldEnd - field);
+                if (!delimiter) {
+                    break;
+                }
+                field = delimiter + 1;
+            }
+
+            double price = 0.0, timestamp = 0.0, volume = 0.0;
+            bool valid = columns > layout.symbolColumn && columns > layout.priceColumn &&
+                         columns > layout.timestampColumn &&
+                         parseDouble(fields[layout.priceColumn], price) &&
+                         parseTimestamp(fields[layout.timestampColumn], timestamp) &&
+                         (columns <= layout.volumeColumn ||
+                          parseDouble(fields[layout.volumeColumn], volume));
+            std::string_view symbol = valid ? trimField(fields[layout.symbolColumn])
+                                            : std::string_view();
+
+            if (valid && !symbol.empty()) {
+                auto inserted = index.emplace(symbol, out.series.size());
+                if (inserted.second) {
+                    out.series.push_back(ChunkSeries{symbol, {}, {}, {}});
+                }
+                ChunkSeries& series = out.series[inserted.first->second];
+                series.prices.push_back(price);
+                series.volumes.push_back(volume);
+                series.timestamps.push_back(timestamp);
+                ++out.rows;
+            } else if (!firstLine) {
+                ++out.skippedRows;
+            }
+        }
+
+        firstLine = false;
+        line = lineEnd + 1;
+    }
+}
+
+void sortByTimestamp(TechnicalIndicator::StockData& stock) {
+    if (std::is_sorted(stock.timestamps.begin(), stock.timestamps.end())) {
+        return;
+    }
+    std::vector<size_t> order(stock.timestamps.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&stock](size_t a, size_t b) {
+        return stock.timestamps[a] < stock.timestamps[b];
+    });
+
+    TechnicalIndicator::StockData sorted;
+    sorted.symbol = std::move(stock.symbol);
+    sorted.symbolId = stock.symbolId;
+    sorted.prices.reserve(order.size());
+    sorted.volumes.reserve(order.size());
+    sorted.timestamps.reserve(order.size());
+    for (size_t i : order) {
+        sorted.prices.push_back(stock.prices[i]);
+        sorted.volumes.push_back(stock.volumes[i]);
+        sorted.timestamps.push_back(stock.timestamps[i]);
+    }
+    stock = std::move(sorted);
+}
+
+}
 
 StockDataFetcher::StockDataFetcher()
     : timeoutSeconds_(5) {
@@ -12,6 +233,7 @@ StockDataFetcher::~StockDataFetcher() {
 TechnicalIndicator::StockData StockDataFetcher::generateSampleData(const std::string& symbol) {
     TechnicalIndicator::StockData stockData;
     stockData.symbol = symbol;
+    stockData.symbolId = SymbolTable::global().intern(symbol);
     
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -45,3 +267,116 @@ std::vector<TechnicalIndicator::StockData> StockDataFetcher::fetchMultipleStocks
     
     return results;
 }
+
+std::vector<TechnicalIndicator::StockData> StockDataFetcher::loadCsv(const std::string& path,
+                                                                     IngestStats* stats) {
+    return loadCsv(path, CsvLayout(), stats);
+}
+
+std::vector<TechnicalIndicator::StockData> StockDataFetcher::loadCsv(const std::string& path,
+                                                                     const CsvLayout& layout,
+                                                                     IngestStats* stats) {
+    validateLayout(layout);
+    auto startTime = std::chrono::steady_clock::now();
+    MappedFile file(path);
+    const char* data = file.data();
+    const size_t size = file.size();
+    
+    int numThreads = 1;
+    #ifdef _OPENMP
+    numThreads = omp_get_max_threads();
+    #endif
+    
+    // Newline-aligned chunk boundaries: each cut moves forward to just past
+    // the next '\n', so no line straddles two chunks.
+    size_t numChunks = std::max<size_t>(1, std::min<size_t>(
+        static_cast<size_t>(numThreads) * kChunksPerThread, size / kMinChunkBytes));
+    std::vector<size_t> bounds(1, 0);
+    for (size_t c = 1; c < numChunks; ++c) {
+        size_t cut = std::max(bounds.back(), size * c / numChunks);
+        const char* newline = static_cast<const char*>(
+            std::memchr(data + cut, '\n', size - cut));
+        cut = newline ? static_cast<size_t>(newline - data) + 1 : size;
+        if (cut > bounds.back() && cut < size) {
+            bounds.push_back(cut);
+        }
+    }
+    bounds.push_back(size);
+    
+    std::vector<ChunkResult> chunks(bounds.size() - 1);
+    const long chunkCount = static_cast<long>(chunks.size());
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+    #endif
+    for (long c = 0; c < chunkCount; ++c) {
+        parseChunk(data + bounds[c], data + bounds[c + 1], layout, c == 0, chunks[c]);
+    }
+    
+    // Merge in chunk order so each symbol keeps its file order, then let
+    // every output series be assembled by a single thread.
+    struct Piece {
+        size_t chunk;
+        size_t series;
+    };
+    std::unordered_map<std::string_view, size_t> symbolIndex;
+    std::vector<std::vector<Piece>> pieces;
+    size_t rows = 0, skippedRows = 0;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        rows += chunks[c].rows;
+        skippedRows += chunks[c].skippedRows;
+        for (size_t s = 0; s < chunks[c].series.size(); ++s) {
+            auto inserted = symbolIndex.emplace(chunks[c].series[s].symbol, pieces.size());
+            if (inserted.second) {
+                pieces.emplace_back();
+            }
+            pieces[inserted.first->second].push_back({c, s});
+        }
+    }
+    
+    // Interned once here, on one thread, so analysis never hits the table
+    std::vector<SymbolTable::Id> ids(pieces.size());
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        const auto& first = pieces[i][0];
+        ids[i] = SymbolTable::global().intern(chunks[first.chunk].series[first.series].symbol);
+    }
+    
+    std::vector<TechnicalIndicator::StockData> stocks(pieces.size());
+    const long symbolCount = static_cast<long>(pieces.size());
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+    #endif
+    for (long i = 0; i < symbolCount; ++i) {
+        TechnicalIndicator::StockData& stock = stocks[i];
+        const auto& parts = pieces[i];
+        
+        size_t total = 0;
+        for (const auto& part : parts) {
+            total += chunks[part.chunk].series[part.series].prices.size();
+        }
+        stock.symbol = std::string(chunks[parts[0].chunk].series[parts[0].series].symbol);
+        stock.symbolId = ids[i];
+        stock.prices.reserve(total);
+        stock.volumes.reserve(total);
+        stock.timestamps.reserve(total);
+        for (const auto& part : parts) {
+            const ChunkSeries& series = chunks[part.chunk].series[part.series];
+            stock.prices.insert(stock.prices.end(), series.prices.begin(), series.prices.end());
+            stock.volumes.insert(stock.volumes.end(), series.volumes.begin(), series.volumes.end());
+            stock.timestamps.insert(stock.timestamps.end(), series.timestamps.begin(),
+                                    series.timestamps.end());
+        }
+        sortByTimestamp(stock);
+    }
+    
+    if (stats) {
+        stats->rows = rows;
+        stats->skippedRows = skippedRows;
+        stats->symbols = stocks.size();
+        stats->bytes = size;
+        stats->threads = numThreads;
+        stats->seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
+    
+    return stocks;
+}
@@ -0,0 +1,48 @@
+#include "../include/SymbolTable.h"
+#include <mutex>
+#include <stdexcept>
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable::Id SymbolTable::intern(std::string_view symbol) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto found = ids_.find(symbol);
+        if (found != ids_.end()) {
+            return found->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto found = ids_.find(symbol);
+    if (found != ids_.end()) {
+        return found->second;
+    }
+    if (names_.size() >= kInvalidId) {
+        throw std::length_error("SymbolTable is full");
+    }
+    Id id = static_cast<Id>(names_.size());
+    // Deque elements never move, so the key can view the stored name.
+    names_.emplace_back(symbol);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+SymbolTable::Id SymbolTable::find(std::string_view symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto found = ids_.find(symbol);
+    return found != ids_.end() ? found->second : kInvalidId;
+}
+
+std::string_view SymbolTable::name(Id id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id < names_.size() ? std::string_view(names_[id]) : std::string_view();
+}
+
+size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
@@ -1,133 +1,181 @@
 #include "../include/TechnicalIndicator.h"
+#include "../include/ColumnarPriceStore.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/PrecisionIndicators.h"
 #include <algorithm>
-#include <numeric>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+namespace {
+
+// Chunks per pool thread; enough slack for stealing to even out the tail.
+constexpr size_t kChunksPerWorker = 8;
+
+// Per-symbol work estimates used to size work-stealing chunks. The snapshot
+// kernels never read more than the longest window, whereas the series
+// kernels are linear in the full history.
+constexpr size_t kSnapshotWindow = 50;
+constexpr size_t kPerSymbolOverhead = 8;
+
+constexpr size_t kBandPeriod = 20;        // Bollinger and VWAP window
+constexpr double kBandWidth = 2.0;
+constexpr size_t kAtrPeriod = 14;
+constexpr size_t kStochasticPeriod = 14;
+constexpr size_t kStochasticSmoothing = 3;
+
+std::vector<size_t> costBalancedBounds(const std::vector<TechnicalIndicator::StockData>& stocks,
+                                       size_t maxCostPerSymbol, size_t numWorkers) {
+    std::vector<size_t> costs(stocks.size());
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        costs[i] = std::min(stocks[i].prices.size(), maxCostPerSymbol) + kPerSymbolOverhead;
+    }
+    return WorkStealingPool::partitionByCost(costs, (numWorkers + 1) * kChunksPerWorker);
+}
+
+}
+
 TechnicalIndicator::TechnicalIndicator() {
 }
 
 TechnicalIndicator::~TechnicalIndicator() {
 }
 
-double TechnicalIndicator::calculateSMA(const std::vector<double>& prices, int period) {
-    if (prices.size() < static_cast<size_t>(period)) {
-        return 0.0;
-    }
-    
-    double sum = 0.0;
-    for (int i = prices.size() - period; i < static_cast<int>(prices.size()); ++i) {
-        sum += prices[i];
-    }
-    return sum / period;
+void TechnicalIndicator::IndicatorColumns::resize(size_t numSymbols) {
+    size = numSymbols;
+    sma_20.resize(paddedToCacheLine<double>(numSymbols));
+    sma_50.resize(paddedToCacheLine<double>(numSymbols));
+    rsi.resize(paddedToCacheLine<double>(numSymbols));
+    macd.resize(paddedToCacheLine<double>(numSymbols));
+    macd_signal.resize(paddedToCacheLine<double>(numSymbols));
+    signal_strength.resize(paddedToCacheLine<double>(numSymbols));
+    signal.resize(paddedToCacheLine<Signal>(numSymbols));
 }
 
-double TechnicalIndicator::calculateRSI(const std::vector<double>& prices, int period) {
-    if (prices.size() < static_cast<size_t>(period + 1)) {
-        return 50.0;
-    }
-    
-    std::vector<double> gains, losses;
-    for (size_t i = prices.size() - period; i < prices.size() - 1; ++i) {
-        double change = prices[i + 1] - prices[i];
-        if (change > 0) {
-            gains.push_back(change);
-            losses.push_back(0.0);
-        } else {
-            gains.push_back(0.0);
-            losses.push_back(-change);
-        }
-    }
-    
-    double avgGain = std::accumulate(gains.begin(), gains.end(), 0.0) / period;
-    double avgLoss = std::accumulate(losses.begin(), losses.end(), 0.0) / period;
-    
-    if (avgLoss == 0.0) {
-        return 100.0;
-    }
-    
-    double rs = avgGain / avgLoss;
-    return 100.0 - (100.0 / (1.0 + rs));
+double TechnicalIndicator::calculateSMA(const double* prices, size_t length, int period) {
+    return PrecisionIndicators<DoublePrecision>::sma(prices, length, period);
 }
 
-std::pair<double, double> TechnicalIndicator::calculateMACD(const std::vector<double>& prices) {
-    if (prices.size() < 26) {
-        return {0.0, 0.0};
-    }
-    
-    double ema12 = prices[prices.size() - 12];
-    double ema26 = prices[prices.size() - 26];
-    
-    double multiplier12 = 2.0 / (12 + 1);
-    double multiplier26 = 2.0 / (26 + 1);
-    
-    for (size_t i = prices.size() - 12 + 1; i < prices.size(); ++i) {
-        ema12 = (prices[i] - ema12) * multiplier12 + ema12;
-    }
-    
-    for (size_t i = prices.size() - 26 + 1; i < prices.size(); ++i) {
-        ema26 = (prices[i] - ema26) * multiplier26 + ema26;
+double TechnicalIndicator::calculateRSI(const double* prices, size_t length, int period) {
+    return PrecisionIndicators<DoublePrecision>::rsi(prices, length, period);
+}
+
+std::pair<double, double> TechnicalIndicator::calculateMACD(const double* prices, size_t length) {
+    return PrecisionIndicators<DoublePrecision>::macd(prices, length);
+}
+
+const char* TechnicalIndicator::signalName(Signal signal) {
+    switch (signal) {
+        case Signal::Buy: return "BUY";
+        case Signal::Sell: return "SELL";
+        case Signal::Hold: break;
     }
-    
-    double macd = ema12 - ema26;
-    double signal = macd * 0.9;
-    
-    return {macd, signal};
+    return "HOLD";
 }
 
-std::string TechnicalIndicator::generateSignal(const IndicatorResult& result) {
+TechnicalIndicator::Signal TechnicalIndicator::classifySignal(
+    double sma20, double sma50, double rsi, double macd, double macdSignal) {
     int buySignals = 0;
     int sellSignals = 0;
     
-    if (result.rsi < 30) buySignals++;
-    else if (result.rsi > 70) sellSignals++;
+    if (rsi < 30) buySignals++;
+    else if (rsi > 70) sellSignals++;
     
-    if (result.macd > result.macd_signal) buySignals++;
-    else if (result.macd < result.macd_signal) sellSignals++;
+    if (macd > macdSignal) buySignals++;
+    else if (macd < macdSignal) sellSignals++;
     
-    if (result.sma_20 > result.sma_50) buySignals++;
-    else if (result.sma_20 < result.sma_50) sellSignals++;
+    if (sma20 > sma50) buySignals++;
+    else if (sma20 < sma50) sellSignals++;
     
-    if (buySignals > sellSignals) return "BUY";
-    if (sellSignals > buySignals) return "SELL";
-    return "HOLD";
+    if (buySignals > sellSignals) return Signal::Buy;
+    if (sellSignals > buySignals) return Signal::Sell;
+    return Signal::Hold;
 }
 
-double TechnicalIndicator::calculateSignalStrength(const IndicatorResult& result) {
+void TechnicalIndicator::internSymbols(std::vector<StockData>& stocks) {
+    SymbolTable& table = SymbolTable::global();
+    for (auto& stock : stocks) {
+        if (stock.symbolId == SymbolTable::kInvalidId) {
+            stock.symbolId = table.intern(stock.symbol);
+        }
+    }
+}
+
+TechnicalIndicator::PriceSeriesView TechnicalIndicator::makeView(const StockData& stockData) {
+    const size_t length = stockData.prices.size();
+    return {stockData.symbol, stockData.prices.data(),
+            stockData.volumes.size() == length ? stockData.volumes.data() : nullptr,
+            stockData.timestamps.size() == length ? stockData.timestamps.data() : nullptr,
+            length, stockData.symbolId};
+}
+
+std::string_view TechnicalIndicator::symbolName(const IndicatorResult& result) {
+    return symbolName(result.symbolId);
+}
+
+std::string_view TechnicalIndicator::symbolName(SymbolTable::Id id) {
+    return SymbolTable::global().name(id);
+}
+
+TechnicalIndicator::Signal TechnicalIndicator::generateSignal(const IndicatorResult& result) {
+    return classifySignal(result.sma_20, result.sma_50, result.rsi,
+                          result.macd, result.macd_signal);
+}
+
+double TechnicalIndicator::calculateSignalStrength(
+    double sma20, double sma50, double rsi, double macd, double macdSignal) {
     double strength = 0.0;
     
-    if (result.rsi < 30) strength += (30 - result.rsi) / 30.0;
-    else if (result.rsi > 70) strength += (result.rsi - 70) / 30.0;
+    if (rsi < 30) strength += (30 - rsi) / 30.0;
+    else if (rsi > 70) strength += (rsi - 70) / 30.0;
     
-    double macdDiff = std::abs(result.macd - result.macd_signal);
+    double macdDiff = std::abs(macd - macdSignal);
     strength += macdDiff * 10.0;
     
-    double smaDiff = std::abs(result.sma_20 - result.sma_50) / result.sma_50;
-    strength += smaDiff * 100.0;
+    // SMA50 reads 0 until 50 bars exist; without it there is no crossover
+    // term, and dividing would make the strength NaN
+    if (sma50 != 0.0) {
+        double smaDiff = std::abs(sma20 - sma50) / sma50;
+        strength += smaDiff * 100.0;
+    }
     
     return std::min(strength, 100.0);
 }
 
+double TechnicalIndicator::calculateSignalStrength(const IndicatorResult& result) {
+    return calculateSignalStrength(result.sma_20, result.sma_50, result.rsi,
+                                   result.macd, result.macd_signal);
+}
+
 TechnicalIndicator::IndicatorResult TechnicalIndicator::computeIndicators(
     const StockData& stockData) {
     
-    IndicatorResult result;
-    result.symbol = stockData.symbol;
+    return computeIndicators(makeView(stockData));
+}
+
+TechnicalIndicator::IndicatorResult TechnicalIndicator::computeIndicators(
+    const PriceSeriesView& series) {
+    
+    IndicatorResult result{};
+    result.symbolId = resolveSymbolId(series);
     
-    if (stockData.prices.empty()) {
-        result.signal = "HOLD";
+    if (series.length == 0) {
+        result.signal = Signal::Hold;
         result.signal_strength = 0.0;
         return result;
     }
     
-    result.sma_20 = calculateSMA(stockData.prices, 20);
-    result.sma_50 = calculateSMA(stockData.prices, 50);
-    result.rsi = calculateRSI(stockData.prices, 14);
+    const double* prices = series.prices;
+    size_t length = series.length;
+    
+    result.sma_20 = calculateSMA(prices, length, 20);
+    result.sma_50 = calculateSMA(prices, length, 50);
+    result.rsi = calculateRSI(prices, length, 14);
     
-    auto macdPair = calculateMACD(stockData.prices);
+    auto macdPair = calculateMACD(prices, length);
     result.macd = macdPair.first;
     result.macd_signal = macdPair.second;
     
@@ -156,3 +204,287 @@ TechnicalIndicator::computeIndicatorsParallel(
     
     return results;
 }
+
+std::vector<TechnicalIndicator::IndicatorResult>
+TechnicalIndicator::computeIndicatorsParallel(
+    const std::vector<PriceSeriesView>& series) {
+    
+    std::vector<IndicatorResult> results(series.size());
+    const long count = static_cast<long>(series.size());
+    
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < count; ++i) {
+        results[i] = computeIndicators(series[i]);
+    }
+    
+    return results;
+}
+
+std::vector<TechnicalIndicator::IndicatorResult>
+TechnicalIndicator::computeIndicatorsParallel(
+    const std::vector<StockData>& stocks, WorkStealingPool& pool) {
+    
+    std::vector<IndicatorResult> results(stocks.size());
+    auto bounds = costBalancedBounds(stocks, kSnapshotWindow, pool.size());
+    
+    pool.parallelFor(bounds, [this, &stocks, &results](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = computeIndicators(stocks[i]);
+        }
+    });
+    
+    return results;
+}
+
+void TechnicalIndicator::computeColumnRow(const double* prices, size_t length,
+                                          IndicatorColumns& out, size_t row) {
+    if (length == 0) {
+        out.sma_20[row] = 0.0;
+        out.sma_50[row] = 0.0;
+        out.rsi[row] = 0.0;
+        out.macd[row] = 0.0;
+        out.macd_signal[row] = 0.0;
+        out.signal[row] = Signal::Hold;
+        out.signal_strength[row] = 0.0;
+        return;
+    }
+    
+    double sma20 = calculateSMA(prices, length, 20);
+    double sma50 = calculateSMA(prices, length, 50);
+    double rsi = calculateRSI(prices, length, 14);
+    auto macdPair = calculateMACD(prices, length);
+    
+    out.sma_20[row] = sma20;
+    out.sma_50[row] = sma50;
+    out.rsi[row] = rsi;
+    out.macd[row] = macdPair.first;
+    out.macd_signal[row] = macdPair.second;
+    out.signal[row] = classifySignal(sma20, sma50, rsi, macdPair.first, macdPair.second);
+    out.signal_strength[row] = calculateSignalStrength(sma20, sma50, rsi,
+                                                       macdPair.first, macdPair.second);
+}
+
+void TechnicalIndicator::computeIndicators(const ColumnarPriceStore& store,
+                                           IndicatorColumns& out) {
+    computeIndicators(store, out, SimdKernels::activeLevel());
+}
+
+void TechnicalIndicator::computeIndicators(const ColumnarPriceStore& store,
+                                           IndicatorColumns& out,
+                                           SimdKernels::Level level) {
+    constexpr size_t kBlock = IndicatorColumns::kColumnBlock;
+    out.resize(store.size());
+    
+    if (!SimdKernels::isSupported(level)) {
+        level = SimdKernels::Level::Scalar;
+    }
+    const size_t lanes = SimdKernels::laneWidth(level);
+    const double* base = store.arena().data();
+    const long numBlocks = static_cast<long>((store.size() + kBlock - 1) / kBlock);
+    
+    // Each block of kBlock rows belongs to one thread, so no two threads
+    // share a cache line in any output column. Within a block, series long
+    // enough for every window are packed into lane groups and advanced in
+    // lockstep; short series and the leftover partial group run scalar.
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+    #endif
+    for (long block = 0; block < numBlocks; ++block) {
+        size_t begin = static_cast<size_t>(block) * kBlock;
+        size_t end = std::min(begin + kBlock, store.size());
+        
+        size_t rows[SimdKernels::kMaxLanes];
+        int64_t windowStart[SimdKernels::kMaxLanes];
+        double sma20[SimdKernels::kMaxLanes], sma50[SimdKernels::kMaxLanes];
+        double rsi[SimdKernels::kMaxLanes], macd[SimdKernels::kMaxLanes];
+        double macdSignal[SimdKernels::kMaxLanes];
+        size_t pending = 0;
+        
+        for (size_t i = begin; i < end; ++i) {
+            size_t length = store.length(i);
+            if (lanes == 1 || length < static_cast<size_t>(SimdKernels::kWindow)) {
+                computeColumnRow(store.prices(i), length, out, i);
+                continue;
+            }
+            
+            rows[pending] = i;
+            windowStart[pending] = static_cast<int64_t>(
+                store.offsets()[i] + length - SimdKernels::kWindow);
+            if (++pending < lanes) {
+                continue;
+            }
+            
+            SimdKernels::snapshotLanes(level, base, windowStart,
+                                       sma20, sma50, rsi, macd, macdSignal);
+            for (size_t j = 0; j < lanes; ++j) {
+                size_t row = rows[j];
+                out.sma_20[row] = sma20[j];
+                out.sma_50[row] = sma50[j];
+                out.rsi[row] = rsi[j];
+                out.macd[row] = macd[j];
+                out.macd_signal[row] = macdSignal[j];
+                out.signal[row] = classifySignal(sma20[j], sma50[j], rsi[j],
+                                                 macd[j], macdSignal[j]);
+                out.signal_strength[row] = calculateSignalStrength(
+                    sma20[j], sma50[j], rsi[j], macd[j], macdSignal[j]);
+            }
+            pending = 0;
+        }
+        
+        for (size_t j = 0; j < pending; ++j) {
+            computeColumnRow(store.prices(rows[j]), store.length(rows[j]), out, rows[j]);
+        }
+    }
+}
+
+TechnicalIndicator::ExtendedIndicators TechnicalIndicator::computeExtendedIndicators(
+    const StockData& stockData) {
+    
+    return computeExtendedIndicators(makeView(stockData));
+}
+
+TechnicalIndicator::ExtendedIndicators TechnicalIndicator::computeExtendedIndicators(
+    const PriceSeriesView& series) {
+    
+    ExtendedIndicators result{};
+    result.symbolId = resolveSymbolId(series);
+    result.stochastic_k = 50.0;
+    result.stochastic_d = 50.0;
+    const size_t length = series.length;
+    if (length == 0) {
+        return result;
+    }
+    const double* prices = series.prices;
+    const double* volumes = series.volumes;
+    
+    // Everything is carried through one sweep. ATR and OBV are recurrences
+    // over the whole series; the windowed indicators only accumulate over
+    // the tail, whose bars are still in cache for the stochastic's
+    // look-back. Band sums are taken relative to the window's first close
+    // so the variance does not cancel catastrophically.
+    const size_t bandStart = length > kBandPeriod ? length - kBandPeriod : 0;
+    const size_t stochasticStart =
+        length > kStochasticSmoothing ? length - kStochasticSmoothing : 0;
+    const double shift = prices[bandStart];
+    double atr = 0.0, obv = 0.0;
+    double sumDev = 0.0, sumDevSq = 0.0, priceVolume = 0.0, volume = 0.0;
+    double percentK[kStochasticSmoothing] = {50.0, 50.0, 50.0};
+    
+    for (size_t t = 0; t < length; ++t) {
+        double price = prices[t];
+        double v = volumes ? volumes[t] : 0.0;
+        
+        if (t > 0) {
+            double change = price - prices[t - 1];
+            double trueRange = std::abs(change);
+            if (t < kAtrPeriod) {
+                atr += trueRange;
+            } else if (t == kAtrPeriod) {
+                atr = (atr + trueRange) / kAtrPeriod;
+            } else {
+                atr = (atr * (kAtrPeriod - 1) + trueRange) / kAtrPeriod;
+            }
+            if (change > 0) obv += v;
+            else if (change < 0) obv -= v;
+        }
+        
+        if (t >= bandStart) {
+            double deviation = price - shift;
+            sumDev += deviation;
+            sumDevSq += deviation * deviation;
+            priceVolume += price * v;
+            volume += v;
+        }
+        
+        if (t >= stochasticStart && t + 1 >= kStochasticPeriod) {
+            const double* window = prices + t + 1 - kStochasticPeriod;
+            double high = window[0], low = window[0];
+            for (size_t k = 1; k < kStochasticPeriod; ++k) {
+                high = std::max(high, window[k]);
+                low = std::min(low, window[k]);
+            }
+            percentK[t - stochasticStart] =
+                high > low ? 100.0 * (price - low) / (high - low) : 50.0;
+        }
+    }
+    
+    const size_t bandCount = length - bandStart;
+    double mean = shift + sumDev / bandCount;
+    if (length >= kBandPeriod) {
+        double meanDev = sumDev / kBandPeriod;
+        double deviation = std::sqrt(std::max(0.0, sumDevSq / kBandPeriod - meanDev * meanDev));
+        result.bollinger_middle = mean;
+        result.bollinger_upper = mean + kBandWidth * deviation;
+        result.bollinger_lower = mean - kBandWidth * deviation;
+    }
+    result.atr = length > kAtrPeriod ? atr : 0.0;
+    result.obv = obv;
+    result.vwap = volume > 0.0 ? priceVolume / volume : mean;
+    
+    const size_t slots = length - stochasticStart;
+    result.stochastic_k = percentK[slots - 1];
+    // Like the other windowed indicators, %D keeps its warm-up value until
+    // every slot it averages holds a real %K
+    if (length >= kStochasticPeriod + kStochasticSmoothing - 1) {
+        double sumK = 0.0;
+        for (size_t k = 0; k < kStochasticSmoothing; ++k) {
+            sumK += percentK[k];
+        }
+        result.stochastic_d = sumK / kStochasticSmoothing;
+    }
+    return result;
+}
+
+std::vector<TechnicalIndicator::ExtendedIndicators>
+TechnicalIndicator::computeExtendedIndicatorsParallel(const std::vector<StockData>& stocks) {
+    
+    std::vector<ExtendedIndicators> results(stocks.size());
+    const long count = static_cast<long>(stocks.size());
+    
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < count; ++i) {
+        results[i] = computeExtendedIndicators(stocks[i]);
+    }
+    
+    return results;
+}
+
+void TechnicalIndicator::computeIndicatorSeries(const StockData& stockData,
+                                                const IndicatorSeries& out) {
+    computeIndicatorSeries(stockData.prices.data(), stockData.prices.size(), out);
+}
+
+void TechnicalIndicator::computeIndicatorSeries(const double* prices, size_t length,
+                                                const IndicatorSeries& out) {
+    PrecisionIndicators<DoublePrecision>::computeSeries(prices, length, out);
+}
+
+void TechnicalIndicator::computeIndicatorSeriesParallel(
+    const std::vector<StockData>& stocks, const std::vector<IndicatorSeries>& outputs) {
+    
+    const long numStocks = static_cast<long>(stocks.size());
+    
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for (long i = 0; i < numStocks; ++i) {
+        computeIndicatorSeries(stocks[i], outputs[i]);
+    }
+}
+
+void TechnicalIndicator::computeIndicatorSeriesParallel(
+    const std::vector<StockData>& stocks, const std::vector<IndicatorSeries>& outputs,
+    WorkStealingPool& pool) {
+    
+    auto bounds = costBalancedBounds(stocks, std::numeric_limits<size_t>::max(), pool.size());
+    
+    pool.parallelFor(bounds, [this, &stocks, &outputs](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            computeIndicatorSeries(stocks[i], outputs[i]);
+        }
+    });
+}
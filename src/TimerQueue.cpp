@@ -0,0 +1,82 @@
+#include "../include/TimerQueue.h"
+
+TimerQueue::TimerQueue() : nextId_(1), stopped_(false) {
+}
+
+TimerQueue::TimerId TimerQueue::scheduleAt(Clock::time_point due, Clock::duration interval,
+                                           Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TimerId id = nextId_++;
+    timers_.emplace(id, Timer{interval, std::move(callback)});
+    bool earliest = deadlines_.empty() || due < deadlines_.top().due;
+    deadlines_.push({due, id});
+    if (earliest) {
+        wakeup_.notify_one();
+    }
+    return id;
+}
+
+bool TimerQueue::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.erase(id) > 0;
+}
+
+void TimerQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+        if (deadlines_.empty()) {
+            wakeup_.wait(lock);
+            continue;
+        }
+
+        Deadline next = deadlines_.top();
+        auto found = timers_.find(next.id);
+        if (found == timers_.end()) {
+            deadlines_.pop();
+            continue;
+        }
+        if (Clock::now() < next.due) {
+            // Woken early by stop() or by an earlier deadline being added
+            wakeup_.wait_until(lock, next.due);
+            continue;
+        }
+
+        deadlines_.pop();
+        Clock::duration interval = found->second.interval;
+        // Copied so cancel() from inside the callback cannot destroy it
+        // while it runs.
+        Callback callback = found->second.callback;
+        if (interval == Clock::duration::zero()) {
+            timers_.erase(found);
+        }
+
+        lock.unlock();
+        callback();
+        lock.lock();
+
+        if (interval != Clock::duration::zero() && timers_.count(next.id) > 0) {
+            Clock::time_point due = next.due + interval;
+            Clock::time_point now = Clock::now();
+            if (due <= now) {
+                due += ((now - due) / interval + 1) * interval;
+            }
+            deadlines_.push({due, next.id});
+        }
+    }
+}
+
+void TimerQueue::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    wakeup_.notify_all();
+}
+
+void TimerQueue::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = false;
+}
+
+size_t TimerQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.size();
+}
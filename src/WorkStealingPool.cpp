@@ -0,0 +1,208 @@
+#include "../include/WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+
+constexpr size_t kNotAWorker = std::numeric_limits<size_t>::max();
+
+thread_local const WorkStealingPool* tlsPool = nullptr;
+thread_local size_t tlsWorkerIndex = kNotAWorker;
+
+uint64_t nextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+}
+
+WorkStealingPool::WorkStealingPool(size_t numWorkers)
+    : stopping_(false), queuedTasks_(0), nextQueue_(0) {
+    if (numWorkers == 0) {
+        numWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    stopping_ = true;
+    workAvailable_.notifyAll();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+WorkStealingPool& WorkStealingPool::shared() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+void WorkStealingPool::enqueue(Task task) {
+    size_t index = (tlsPool == this)
+        ? tlsWorkerIndex
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    queuedTasks_.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void WorkStealingPool::submit(Task task) {
+    enqueue(std::move(task));
+    workAvailable_.notifyAll();
+}
+
+bool WorkStealingPool::popLocal(size_t index, Task& task) {
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t victim, Task& task) {
+    WorkerQueue& queue = *queues_[victim];
+    std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::runOne(size_t self, uint64_t& rngState) {
+    if (queuedTasks_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    Task task;
+    bool found = (self != kNotAWorker) && popLocal(self, task);
+    if (!found) {
+        size_t count = queues_.size();
+        size_t start = static_cast<size_t>(nextRandom(rngState) % count);
+        for (size_t k = 0; k < count && !found; ++k) {
+            size_t victim = (start + k) % count;
+            found = (victim != self) && steal(victim, task);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    tlsPool = this;
+    tlsWorkerIndex = index;
+    uint64_t rngState = 0x9E3779B97F4A7C15ULL * (index + 1);
+
+    for (;;) {
+        if (runOne(index, rngState)) {
+            continue;
+        }
+
+        uint32_t key = workAvailable_.prepareWait();
+        if (queuedTasks_.load(std::memory_order_seq_cst) > 0) {
+            workAvailable_.cancelWait();
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            workAvailable_.cancelWait();
+            break;
+        }
+        workAvailable_.wait(key, std::chrono::seconds(1));
+    }
+}
+
+void WorkStealingPool::parallelFor(const std::vector<size_t>& bounds,
+                                   const std::function<void(size_t, size_t)>& body) {
+    if (bounds.size() < 2) {
+        return;
+    }
+    size_t chunks = bounds.size() - 1;
+
+    std::atomic<size_t> remaining(chunks);
+    for (size_t i = 1; i < chunks; ++i) {
+        enqueue([this, &bounds, &body, &remaining, i] {
+            body(bounds[i], bounds[i + 1]);
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                chunkFinished_.notifyAll();
+            }
+        });
+    }
+    if (chunks > 1) {
+        workAvailable_.notifyAll();
+    }
+
+    body(bounds[0], bounds[1]);
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+
+    size_t self = (tlsPool == this) ? tlsWorkerIndex : kNotAWorker;
+    uint64_t rngState = reinterpret_cast<uintptr_t>(&remaining) | 1;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (runOne(self, rngState)) {
+            continue;
+        }
+        // Nothing left to steal: the last chunks are running elsewhere.
+        uint32_t key = chunkFinished_.prepareWait();
+        if (remaining.load(std::memory_order_seq_cst) == 0 ||
+            queuedTasks_.load(std::memory_order_seq_cst) > 0) {
+            chunkFinished_.cancelWait();
+            continue;
+        }
+        chunkFinished_.wait(key, std::chrono::milliseconds(10));
+    }
+}
+
+std::vector<size_t> WorkStealingPool::partitionByCost(const std::vector<size_t>& costs,
+                                                      size_t targetChunks) {
+    std::vector<size_t> bounds(1, 0);
+    if (costs.empty()) {
+        return bounds;
+    }
+
+    size_t total = 0;
+    for (size_t cost : costs) {
+        total += cost;
+    }
+    targetChunks = std::max<size_t>(1, targetChunks);
+    size_t perChunk = std::max<size_t>(1, (total + targetChunks - 1) / targetChunks);
+
+    size_t accumulated = 0;
+    for (size_t i = 0; i < costs.size(); ++i) {
+        if (costs[i] >= perChunk && accumulated > 0) {
+            bounds.push_back(i);
+            accumulated = 0;
+        }
+        accumulated += costs[i];
+        if (accumulated >= perChunk) {
+            bounds.push_back(i + 1);
+            accumulated = 0;
+        }
+    }
+    if (bounds.back() != costs.size()) {
+        bounds.push_back(costs.size());
+    }
+    return bounds;
+}
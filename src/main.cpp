@@ -1,6 +1,9 @@
 #include "../include/TechnicalIndicator.h"
 #include "../include/Scheduler.h"
 #include "../include/PerformanceVisualizer.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/Backtester.h"
+#include "../include/NumaIndicatorEngine.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -8,6 +11,8 @@
 #include <random>
 #include <algorithm>
 #include <thread>
+#include <fstream>
+#include <functional>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -56,6 +61,7 @@ std::vector<TechnicalIndicator::StockData> generateSampleData(int numStocks) {
     for (int i = 0; i < numStocks && i < static_cast<int>(symbols.size()); ++i) {
         TechnicalIndicator::StockData stock;
         stock.symbol = symbols[i];
+        stock.symbolId = SymbolTable::global().intern(stock.symbol);
         
         double basePrice = priceDist(gen);
         for (int day = 0; day < 100; ++day) {
@@ -71,6 +77,7 @@ std::vector<TechnicalIndicator::StockData> generateSampleData(int numStocks) {
     while (static_cast<int>(stocks.size()) < numStocks) {
         TechnicalIndicator::StockData stock = stocks[stocks.size() % symbols.size()];
         stock.symbol = "STOCK" + std::to_string(stocks.size());
+        stock.symbolId = SymbolTable::global().intern(stock.symbol);
         stocks.push_back(stock);
     }
     
@@ -82,6 +89,7 @@ std::vector<TechnicalIndicator::IndicatorResult> computeSequential(
     
     TechnicalIndicator indicator;
     std::vector<TechnicalIndicator::IndicatorResult> results;
+    results.reserve(stocks.size());
     
     for (const auto& stock : stocks) {
         results.push_back(indicator.computeIndicators(stock));
@@ -97,6 +105,418 @@ std::vector<TechnicalIndicator::IndicatorResult> computeParallel(
     return indicator.computeIndicatorsParallel(stocks);
 }
 
+// Universe where a minority of long-history names sits next to many
+// recent listings, the case where a static schedule leaves threads idle.
+std::vector<TechnicalIndicator::StockData> generateSkewedData(int numStocks) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> shortLength(60, 500);
+    std::uniform_int_distribution<int> longLength(5000, 7560);
+    std::normal_distribution<double> returns(0.0, 0.01);
+    
+    std::vector<TechnicalIndicator::StockData> stocks(numStocks);
+    for (int i = 0; i < numStocks; ++i) {
+        TechnicalIndicator::StockData& stock = stocks[i];
+        stock.symbol = "SKEW" + std::to_string(i);
+        stock.symbolId = SymbolTable::global().intern(stock.symbol);
+        int length = (i < numStocks * 15 / 100) ? longLength(gen) : shortLength(gen);
+        double price = 100.0;
+        stock.prices.reserve(length);
+        for (int day = 0; day < length; ++day) {
+            price *= 1.0 + returns(gen);
+            stock.prices.push_back(price);
+        }
+    }
+    return stocks;
+}
+
+void runSkewedBenchmark(int numStocks) {
+    std::cout << "\n=== Skewed Workload: OpenMP vs Work-Stealing Pool ===\n";
+    
+    auto stocks = generateSkewedData(numStocks);
+    size_t totalBars = 0;
+    for (const auto& stock : stocks) {
+        totalBars += stock.prices.size();
+    }
+    std::cout << "Stocks: " << stocks.size() << ", total bars: " << totalBars << "\n";
+    
+    auto makeOutputs = [&stocks](std::vector<std::vector<double>>& storage) {
+        std::vector<TechnicalIndicator::IndicatorSeries> outputs(stocks.size());
+        storage.assign(stocks.size() * 5, {});
+        for (size_t i = 0; i < stocks.size(); ++i) {
+            for (size_t k = 0; k < 5; ++k) {
+                storage[i * 5 + k].resize(stocks[i].prices.size());
+            }
+            outputs[i] = {storage[i * 5].data(), storage[i * 5 + 1].data(),
+                          storage[i * 5 + 2].data(), storage[i * 5 + 3].data(),
+                          storage[i * 5 + 4].data()};
+        }
+        return outputs;
+    };
+    std::vector<std::vector<double>> ompStorage, poolStorage;
+    auto ompOutputs = makeOutputs(ompStorage);
+    auto poolOutputs = makeOutputs(poolStorage);
+    
+    TechnicalIndicator indicator;
+    WorkStealingPool& pool = WorkStealingPool::shared();
+    const int iterations = 10;
+    PerformanceMonitor monitor;
+    
+    // Warm both paths once so thread start-up is not timed
+    indicator.computeIndicatorSeriesParallel(stocks, ompOutputs);
+    indicator.computeIndicatorSeriesParallel(stocks, poolOutputs, pool);
+    
+    monitor.start();
+    for (int i = 0; i < iterations; ++i) {
+        indicator.computeIndicatorSeriesParallel(stocks, ompOutputs);
+    }
+    monitor.stop();
+    double ompSeries = monitor.getElapsedSeconds() / iterations;
+    
+    monitor.start();
+    for (int i = 0; i < iterations; ++i) {
+        indicator.computeIndicatorSeriesParallel(stocks, poolOutputs, pool);
+    }
+    monitor.stop();
+    double poolSeries = monitor.getElapsedSeconds() / iterations;
+    
+    monitor.start();
+    for (int i = 0; i < iterations; ++i) {
+        auto results = indicator.computeIndicatorsParallel(stocks);
+        (void)results;
+    }
+    monitor.stop();
+    double ompSnapshot = monitor.getElapsedSeconds() / iterations;
+    
+    monitor.start();
+    for (int i = 0; i < iterations; ++i) {
+        auto results = indicator.computeIndicatorsParallel(stocks, pool);
+        (void)results;
+    }
+    monitor.stop();
+    double poolSnapshot = monitor.getElapsedSeconds() / iterations;
+    
+    bool match = (ompStorage == poolStorage);
+    
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Pool workers: " << pool.size() << "\n";
+    std::cout << "Full series  - OpenMP static: " << ompSeries << " s, work-stealing: "
+              << poolSeries << " s (" << std::setprecision(2)
+              << (poolSeries > 0 ? ompSeries / poolSeries : 0.0) << "x)\n";
+    std::cout << std::setprecision(6);
+    std::cout << "Snapshot     - OpenMP static: " << ompSnapshot << " s, work-stealing: "
+              << poolSnapshot << " s (" << std::setprecision(2)
+              << (poolSnapshot > 0 ? ompSnapshot / poolSnapshot : 0.0) << "x)\n";
+    std::cout << "Series results match: " << (match ? "Yes" : "No") << "\n";
+}
+
+// Uniform universe with every series the same length, so problem size is
+// exactly symbols x bars.
+std::vector<TechnicalIndicator::StockData> generateUniformData(int numStocks, int bars) {
+    std::mt19937 gen(7);
+    std::normal_distribution<double> returns(0.0, 0.01);
+    
+    std::vector<TechnicalIndicator::StockData> stocks(numStocks);
+    for (int i = 0; i < numStocks; ++i) {
+        TechnicalIndicator::StockData& stock = stocks[i];
+        stock.symbol = "SWEEP" + std::to_string(i);
+        stock.symbolId = SymbolTable::global().intern(stock.symbol);
+        double price = 100.0;
+        stock.prices.reserve(bars);
+        for (int day = 0; day < bars; ++day) {
+            price *= 1.0 + returns(gen);
+            stock.prices.push_back(price);
+        }
+    }
+    return stocks;
+}
+
+struct ScalingPoint {
+    std::string kernel;
+    std::string mode;
+    int threads;
+    int symbols;
+    int bars;
+    double seconds;
+    double speedup;
+    double efficiency;
+    double serialFraction;
+};
+
+// Karp-Flatt experimentally determined serial fraction. A value that grows
+// with the thread count points at parallel overhead rather than a fixed
+// serial part; undefined for a single thread.
+double karpFlatt(double speedup, int threads) {
+    if (threads < 2 || speedup <= 0) {
+        return 0.0;
+    }
+    return (1.0 / speedup - 1.0 / threads) / (1.0 - 1.0 / threads);
+}
+
+// Median of repeated runs after one untimed warmup run.
+double medianSeconds(int repeats, const std::function<void()>& body) {
+    body();
+    std::vector<double> samples;
+    PerformanceMonitor monitor;
+    for (int i = 0; i < repeats; ++i) {
+        monitor.start();
+        body();
+        monitor.stop();
+        samples.push_back(monitor.getElapsedSeconds());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// "snapshot" is computeIndicatorsParallel (work per symbol is bounded by
+// the indicator window); "series" is computeIndicatorSeriesParallel (work
+// grows with series length).
+double timeKernel(const std::string& kernel, const std::vector<TechnicalIndicator::StockData>& stocks,
+                  int threads) {
+    const int repeats = 5;
+    #ifdef _OPENMP
+    omp_set_num_threads(threads);
+    #else
+    (void)threads;
+    #endif
+    
+    TechnicalIndicator indicator;
+    if (kernel == "snapshot") {
+        return medianSeconds(repeats, [&indicator, &stocks] {
+            auto results = indicator.computeIndicatorsParallel(stocks);
+            (void)results;
+        });
+    }
+    
+    std::vector<double> storage;
+    size_t total = 0;
+    for (const auto& stock : stocks) {
+        total += stock.prices.size();
+    }
+    storage.resize(total * 5);
+    std::vector<TechnicalIndicator::IndicatorSeries> outputs(stocks.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        size_t n = stocks[i].prices.size();
+        double* base = storage.data() + offset * 5;
+        outputs[i] = {base, base + n, base + 2 * n, base + 3 * n, base + 4 * n};
+        offset += n;
+    }
+    return medianSeconds(repeats, [&indicator, &stocks, &outputs] {
+        indicator.computeIndicatorSeriesParallel(stocks, outputs);
+    });
+}
+
+void printScalingRows(const std::vector<ScalingPoint>& points, size_t first) {
+    std::cout << std::right << std::setw(8) << "Threads" << std::setw(9) << "Symbols"
+              << std::setw(8) << "Bars" << std::setw(13) << "Time (s)" << std::setw(10) << "Speedup"
+              << std::setw(12) << "Efficiency" << std::setw(13) << "Karp-Flatt" << "\n";
+    for (size_t i = first; i < points.size(); ++i) {
+        const ScalingPoint& p = points[i];
+        std::cout << std::setw(8) << p.threads << std::setw(9) << p.symbols << std::setw(8) << p.bars
+                  << std::setw(13) << std::fixed << std::setprecision(6) << p.seconds
+                  << std::setw(9) << std::setprecision(2) << p.speedup << "x"
+                  << std::setw(11) << std::setprecision(1) << p.efficiency * 100 << "%"
+                  << std::setw(13) << std::setprecision(3);
+        if (p.threads > 1) {
+            std::cout << p.serialFraction << "\n";
+        } else {
+            std::cout << "-" << "\n";
+        }
+    }
+    std::cout << std::left;
+}
+
+// Strong scaling: fixed problem, growing thread count. Weak scaling: the
+// number of symbols grows with the thread count, and speedup is the scaled
+// (Gustafson) speedup threads * T(1) / T(threads).
+void runScalingSweep(int baseStocks, const std::string& csvPath) {
+    int maxThreads = 1;
+    #ifdef _OPENMP
+    maxThreads = omp_get_max_threads();
+    #endif
+    std::vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+    
+    const std::vector<int> symbolCounts = {baseStocks, baseStocks * 4};
+    const std::vector<int> lengths = {250, 1000};
+    const int weakBars = 1000;
+    const std::vector<std::string> kernels = {"snapshot", "series"};
+    std::vector<ScalingPoint> points;
+    
+    std::cout << "\n=== Scaling Sweep ===\n";
+    std::cout << "Thread counts: ";
+    for (int t : threadCounts) {
+        std::cout << t << " ";
+    }
+    std::cout << "(median of 5 runs each)\n";
+    
+    for (const auto& kernel : kernels) {
+        for (int symbols : symbolCounts) {
+            for (int bars : lengths) {
+                auto stocks = generateUniformData(symbols, bars);
+                std::cout << "\n--- Strong scaling: " << kernel << ", " << symbols << " symbols x "
+                          << bars << " bars ---\n";
+                size_t first = points.size();
+                double baseline = 0.0;
+                std::vector<double> speedups;
+                for (int threads : threadCounts) {
+                    double seconds = timeKernel(kernel, stocks, threads);
+                    if (threads == 1) {
+                        baseline = seconds;
+                    }
+                    double speedup = seconds > 0 ? baseline / seconds : 0.0;
+                    points.push_back({kernel, "strong", threads, symbols, bars, seconds, speedup,
+                                      speedup / threads, karpFlatt(speedup, threads)});
+                    speedups.push_back(speedup);
+                }
+                printScalingRows(points, first);
+                PerformanceVisualizer::plotScalability(threadCounts, speedups, "Threads");
+            }
+        }
+    }
+    
+    for (const auto& kernel : kernels) {
+        std::cout << "\n--- Weak scaling: " << kernel << ", " << baseStocks << " symbols per thread x "
+                  << weakBars << " bars ---\n";
+        size_t first = points.size();
+        double baseline = 0.0;
+        std::vector<double> speedups;
+        for (int threads : threadCounts) {
+            auto stocks = generateUniformData(baseStocks * threads, weakBars);
+            double seconds = timeKernel(kernel, stocks, threads);
+            if (threads == 1) {
+                baseline = seconds;
+            }
+            double efficiency = seconds > 0 ? baseline / seconds : 0.0;
+            double speedup = threads * efficiency;
+            points.push_back({kernel, "weak", threads, baseStocks * threads, weakBars, seconds,
+                              speedup, efficiency, karpFlatt(speedup, threads)});
+            speedups.push_back(speedup);
+        }
+        printScalingRows(points, first);
+        PerformanceVisualizer::plotScalability(threadCounts, speedups, "Threads");
+    }
+    
+    #ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+    #endif
+    
+    std::ofstream csv(csvPath);
+    if (!csv) {
+        std::cerr << "Cannot write " << csvPath << "\n";
+        return;
+    }
+    csv << "kernel,mode,threads,symbols,bars,seconds,speedup,efficiency,karp_flatt\n";
+    csv << std::setprecision(9);
+    for (const auto& p : points) {
+        csv << p.kernel << "," << p.mode << "," << p.threads << "," << p.symbols << ","
+            << p.bars << "," << p.seconds << "," << p.speedup << "," << p.efficiency << ",";
+        if (p.threads > 1) {
+            csv << p.serialFraction;
+        }
+        csv << "\n";
+    }
+    std::cout << "\nSweep results written to " << csvPath << "\n";
+}
+
+// Walk-forward backtest of the signal rules over 20 years of daily bars per
+// symbol under a few sizing/cost/shorting variants.
+void runBacktest(int numStocks) {
+    const int bars = 252 * 20;
+    std::cout << "\n=== Walk-Forward Backtest: " << numStocks << " symbols x " << bars
+              << " bars ===\n";
+    auto stocks = generateUniformData(numStocks, bars);
+    
+    std::vector<std::string> labels = {"long-only", "long-only, strength-scaled",
+                                       "long/short", "long-only, min strength 5"};
+    std::vector<Backtester::Params> params(labels.size());
+    params[1].sizing = Backtester::Sizing::StrengthScaled;
+    params[2].allowShort = true;
+    params[3].minStrength = 5.0;
+    
+    Backtester backtester;
+    auto start = std::chrono::steady_clock::now();
+    auto reports = backtester.run(stocks, params);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << std::left << std::setw(28) << "Parameters" << std::right
+              << std::setw(13) << "Mean return" << std::setw(14) << "Mean max DD"
+              << std::setw(10) << "Hit rate" << std::setw(12) << "Trades" << "\n";
+    for (size_t p = 0; p < params.size(); ++p) {
+        double returns = 0.0, drawdown = 0.0;
+        size_t trades = 0, wins = 0;
+        for (size_t s = 0; s < stocks.size(); ++s) {
+            const Backtester::Report& report = reports[s * params.size() + p];
+            returns += report.totalReturn;
+            drawdown += report.maxDrawdown;
+            trades += report.trades;
+            wins += report.winningTrades;
+        }
+        double count = std::max<size_t>(1, stocks.size());
+        std::cout << std::left << std::setw(28) << labels[p] << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(2) << returns / count * 100 << "%"
+                  << std::setw(13) << drawdown / count * 100 << "%"
+                  << std::setw(9) << (trades > 0 ? 100.0 * wins / trades : 0.0) << "%"
+                  << std::setw(12) << trades << "\n";
+    }
+    std::cout << std::left << "Backtested " << static_cast<long long>(stocks.size()) * bars * params.size()
+              << " symbol-bar-parameter steps in " << std::setprecision(3) << seconds << " s\n";
+}
+
+// Plain computeIndicatorsParallel against the node-partitioned, pinned
+// engine, with per-node throughput.
+void runNuma(int numStocks) {
+    const int bars = 252 * 4;
+    const int iterations = 20;
+    NumaTopology topology = NumaTopology::detect();
+    std::cout << "\n=== NUMA-Aware Compute: " << numStocks << " symbols x " << bars
+              << " bars ===\n";
+    for (const auto& node : topology.nodes()) {
+        std::cout << "Node " << node.id << ": " << node.cpus.size() << " CPUs\n";
+    }
+    if (!topology.isMultiNode()) {
+        std::cout << "Single NUMA node: running unpinned, same as the plain parallel path\n";
+    }
+    
+    auto stocks = generateUniformData(numStocks, bars);
+    TechnicalIndicator indicator;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TechnicalIndicator::IndicatorResult> plain;
+    for (int i = 0; i < iterations; ++i) {
+        plain = indicator.computeIndicatorsParallel(stocks);
+    }
+    double plainSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+    
+    NumaIndicatorEngine engine(topology);
+    engine.load(stocks);
+    start = std::chrono::steady_clock::now();
+    std::vector<TechnicalIndicator::IndicatorResult> placed;
+    for (int i = 0; i < iterations; ++i) {
+        placed = engine.compute();
+    }
+    double numaSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+    
+    std::cout << std::fixed << std::setprecision(6)
+              << "Unpinned parallel: " << plainSeconds << " s per pass\n"
+              << "NUMA-aware:        " << numaSeconds << " s per pass"
+              << (placed == plain ? "" : " (RESULTS DIFFER)") << "\n\n";
+    std::cout << std::left << std::setw(6) << "Node" << std::right << std::setw(6) << "CPUs"
+              << std::setw(8) << "Pinned" << std::setw(10) << "Symbols"
+              << std::setw(16) << "Symbols/s" << std::setw(16) << "Mbars/s" << "\n";
+    for (const auto& node : engine.nodeStats()) {
+        std::cout << std::left << std::setw(6) << node.node << std::right << std::setw(6)
+                  << node.cpus << std::setw(8) << (node.pinned ? "yes" : "no")
+                  << std::setw(10) << node.symbols << std::setprecision(0)
+                  << std::setw(16) << node.symbolsPerSecond() << std::setprecision(2)
+                  << std::setw(16) << node.barsPerSecond() / 1e6 << "\n";
+    }
+}
+
 void printResults(const std::vector<TechnicalIndicator::IndicatorResult>& results) {
     std::cout << "\n=== Analysis Results ===\n";
     std::cout << std::left << std::setw(10) << "Symbol"
@@ -109,8 +529,8 @@ void printResults(const std::vector<TechnicalIndicator::IndicatorResult>& result
     std::cout << std::string(72, '-') << "\n";
     
     for (const auto& result : results) {
-        std::cout << std::left << std::setw(10) << result.symbol
-                  << std::setw(10) << result.signal
+        std::cout << std::left << std::setw(10) << TechnicalIndicator::symbolName(result)
+                  << std::setw(10) << TechnicalIndicator::signalName(result.signal)
                   << std::setw(12) << std::fixed << std::setprecision(2) << result.signal_strength
                   << std::setw(10) << std::fixed << std::setprecision(2) << result.rsi
                   << std::setw(10) << std::fixed << std::setprecision(2) << result.sma_20
@@ -132,6 +552,10 @@ int main(int argc, char* argv[]) {
     
     int numStocks = 10;
     bool runScheduler = false;
+    bool runSkewed = false;
+    bool runSweep = false;
+    bool runBacktestMode = false;
+    bool runNumaMode = false;
     bool benchmark = true;
     
     if (argc > 1) {
@@ -139,6 +563,10 @@ int main(int argc, char* argv[]) {
     }
     if (argc > 2) {
         runScheduler = (std::string(argv[2]) == "scheduler");
+        runSkewed = (std::string(argv[2]) == "skewed");
+        runSweep = (std::string(argv[2]) == "sweep");
+        runBacktestMode = (std::string(argv[2]) == "backtest");
+        runNumaMode = (std::string(argv[2]) == "numa");
     }
     if (argc > 3) {
         benchmark = (std::string(argv[3]) != "no-benchmark");
@@ -203,7 +631,7 @@ int main(int argc, char* argv[]) {
         bool resultsMatch = true;
         if (sequentialResults.size() == parallelResults.size()) {
             for (size_t i = 0; i < sequentialResults.size(); ++i) {
-                if (sequentialResults[i].symbol != parallelResults[i].symbol ||
+                if (sequentialResults[i].symbolId != parallelResults[i].symbolId ||
                     std::abs(sequentialResults[i].rsi - parallelResults[i].rsi) > 0.01) {
                     resultsMatch = false;
                     break;
@@ -223,14 +651,30 @@ int main(int argc, char* argv[]) {
         printResults(sampleResults);
     }
     
+    if (runSkewed) {
+        runSkewedBenchmark(numStocks);
+    }
+    
+    if (runSweep) {
+        runScalingSweep(numStocks, "scaling_sweep.csv");
+    }
+    
+    if (runBacktestMode) {
+        runBacktest(numStocks);
+    }
+    
+    if (runNumaMode) {
+        runNuma(numStocks);
+    }
+    
     if (runScheduler) {
         std::cout << "\n=== Starting Scheduler Mode ===\n";
         
         TechnicalIndicator indicator;
-        Scheduler scheduler(3600);
+        Scheduler scheduler(3600, Scheduler::QueueKind::Mpmc);
         
         scheduler.setAnalysisCallback([&indicator, &scheduler](
-            const std::vector<TechnicalIndicator::StockData>& stocks) {
+            const std::vector<TechnicalIndicator::PriceSeriesView>& stocks) {
             
             std::cout << "\n[Scheduler] Running analysis on " << stocks.size() << " stocks\n";
             
@@ -242,25 +686,29 @@ int main(int argc, char* argv[]) {
             std::cout << "[Scheduler] Analysis completed in " 
                       << monitor.getElapsedMilliseconds() << " ms\n";
             
-            for (const auto& result : results) {
-                scheduler.getNotificationQueue().push(result);
-            }
+            scheduler.getNotificationQueue().pushBulk(results.data(), results.size());
         });
         
         scheduler.setNotificationCallback([](const TechnicalIndicator::IndicatorResult& result) {
-            std::cout << "[Notification] " << result.signal << " signal for " 
-                      << result.symbol << " (Strength: " << result.signal_strength << ")\n";
+            std::cout << "[Notification] " << TechnicalIndicator::signalName(result.signal)
+                      << " signal for " << TechnicalIndicator::symbolName(result) << " (Strength: " << result.signal_strength << ")\n";
         });
         
-        for (const auto& stock : stocks) {
-            scheduler.addStockData(stock);
-        }
+        scheduler.addStockData(stocks);
         
+        scheduler.setMetricsDump("scheduler_metrics.prom", 10);
         scheduler.start();
         
         std::cout << "Running scheduler (hourly cycles). Press Ctrl+C to stop...\n";
+        std::cout << "Metrics are written to scheduler_metrics.prom every 10 seconds\n";
         std::this_thread::sleep_for(std::chrono::hours(1));
         
+        auto stream = scheduler.streamStats();
+        std::cout << "\n[Ingest] " << stream.updatesReceived << " updates in "
+                  << stream.batchesDrained << " batches, " << stream.symbolsChanged
+                  << " symbol recomputations, " << stream.updatesPerSecond << " updates/s, "
+                  << "queue depth " << stream.queueDepth << " (peak " << stream.peakQueueDepth
+                  << ")\n";
         scheduler.stop();
         std::cout << "\nScheduler stopped\n";
     }
@@ -1,8 +1,76 @@
 #include "../include/TechnicalIndicator.h"
+#include "../include/ColumnarPriceStore.h"
+#include "../include/IncrementalIndicator.h"
+#include "../include/RingQueues.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/BinaryHistory.h"
+#include "../include/StockDataFetcher.h"
+#include "../include/LatencyHistogram.h"
+#include "../include/TimestampedQueue.h"
+#include "../include/TimerQueue.h"
+#include "../include/Scheduler.h"
+#include "../include/IndicatorGrid.h"
+#include "../include/Backtester.h"
+#include "../include/CorrelationEngine.h"
+#include "../include/IndicatorPipeline.h"
+#include "../include/NumaIndicatorEngine.h"
+#include "../include/ScratchArena.h"
+#include "../include/PrecisionIndicators.h"
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <vector>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <filesystem>
+#include <random>
+#include <cstdlib>
+#include <new>
+
+// Counts every heap allocation in the test binary, so hot paths can be
+// checked for zero malloc traffic.
+static std::atomic<size_t> gHeapAllocations{0};
+
+void* operator new(std::size_t size) {
+    gHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    gHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// These deletes pair with the malloc-backed news above, but once GCC
+// inlines them into callers it sees free() on a new-expression result and
+// reports -Wmismatched-new-delete; the pairing is correct, so silence it
+// for these four definitions only.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
 // Test helper: Check if two doubles are approximately equal
 bool approxEqual(double a, double b, double epsilon = 0.01) {
@@ -93,7 +161,9 @@ void testSignalGeneration() {
     auto result = indicator.computeIndicators(stock);
     
     // Signal should be one of: BUY, SELL, or HOLD
-    assert(result.signal == "BUY" || result.signal == "SELL" || result.signal == "HOLD");
+    assert(result.signal == TechnicalIndicator::Signal::Buy ||
+           result.signal == TechnicalIndicator::Signal::Sell ||
+           result.signal == TechnicalIndicator::Signal::Hold);
     assert(result.signal_strength >= 0.0 && result.signal_strength <= 100.0);
     
     std::cout << "PASSED\n";
@@ -129,7 +199,7 @@ void testParallelConsistency() {
     assert(sequentialResults.size() == parallelResults.size());
     
     for (size_t i = 0; i < sequentialResults.size(); ++i) {
-        assert(sequentialResults[i].symbol == parallelResults[i].symbol);
+        assert(sequentialResults[i].symbolId == parallelResults[i].symbolId);
         assert(approxEqual(sequentialResults[i].rsi, parallelResults[i].rsi));
         assert(approxEqual(sequentialResults[i].sma_20, parallelResults[i].sma_20));
         assert(approxEqual(sequentialResults[i].sma_50, parallelResults[i].sma_50));
@@ -149,7 +219,7 @@ void testEdgeCases() {
     TechnicalIndicator::StockData emptyStock;
     emptyStock.symbol = "EMPTY";
     auto result1 = indicator.computeIndicators(emptyStock);
-    assert(result1.signal == "HOLD");
+    assert(result1.signal == TechnicalIndicator::Signal::Hold);
     assert(result1.signal_strength == 0.0);
     
     // Insufficient data for indicators
@@ -160,7 +230,1697 @@ void testEdgeCases() {
     }
     auto result2 = indicator.computeIndicators(smallStock);
     // Should handle gracefully without crashing
-    assert(result2.symbol == "SMALL");
+    assert(TechnicalIndicator::symbolName(result2) == "SMALL");
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 7: Columnar Store Batch vs Per-Symbol Consistency
+void testColumnarBatch() {
+    std::cout << "Test 7: Columnar Store Batch Consistency... ";
+    
+    TechnicalIndicator indicator;
+    std::vector<TechnicalIndicator::StockData> stocks;
+    
+    // Mixed lengths, including empty and short series
+    for (int i = 0; i < 100; ++i) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = "STOCK" + std::to_string(i);
+        int length = (i % 7 == 0) ? i % 30 : 60 + i;
+        for (int j = 0; j < length; ++j) {
+            stock.prices.push_back(100.0 + std::sin(j * 0.3 + i) * 5.0 + j * 0.1);
+        }
+        stocks.push_back(stock);
+    }
+    
+    auto store = ColumnarPriceStore::fromStockData(stocks);
+    assert(store.size() == stocks.size());
+    assert(store.length(3) == stocks[3].prices.size());
+    assert(store.symbol(3) == "STOCK3");
+    
+    TechnicalIndicator::IndicatorColumns columns;
+    indicator.computeIndicators(store, columns);
+    assert(columns.size == stocks.size());
+    assert(columns.rsi.size() % (kCacheLineSize / sizeof(double)) == 0);
+    assert(reinterpret_cast<uintptr_t>(columns.sma_20.data()) % kCacheLineSize == 0);
+    
+    // Empty series included: both paths report the zeroed result
+    assert(stocks[0].prices.empty());
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        auto expected = indicator.computeIndicators(stocks[i]);
+        assert(approxEqual(expected.sma_20, columns.sma_20[i]));
+        assert(approxEqual(expected.sma_50, columns.sma_50[i]));
+        assert(approxEqual(expected.rsi, columns.rsi[i]));
+        assert(approxEqual(expected.macd, columns.macd[i]));
+        assert(approxEqual(expected.macd_signal, columns.macd_signal[i]));
+        assert(approxEqual(expected.signal_strength, columns.signal_strength[i]));
+        assert(expected.signal == columns.signal[i]);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 8: SIMD Kernels vs Scalar Path (differential)
+void testSimdDifferential() {
+    std::cout << "Test 8: SIMD vs Scalar Differential... ";
+    
+    TechnicalIndicator indicator;
+    ColumnarPriceStore store;
+    
+    // Random walks with varied lengths so lane groups mix with scalar tails
+    unsigned int seed = 12345;
+    for (int i = 0; i < 203; ++i) {
+        int length = (i % 11 == 0) ? 20 + i % 40 : 50 + (i * 37) % 400;
+        std::vector<double> prices;
+        double price = 50.0 + i;
+        for (int j = 0; j < length; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            price += ((seed >> 16) % 2001 - 1000) / 1000.0;
+            // Flat stretches exercise the zero-change and zero-loss branches
+            prices.push_back(i % 13 == 0 ? 100.0 : price);
+        }
+        store.addSeries("SYM" + std::to_string(i), prices.data(), prices.size());
+    }
+    
+    TechnicalIndicator::IndicatorColumns scalar;
+    indicator.computeIndicators(store, scalar, SimdKernels::Level::Scalar);
+    
+    const SimdKernels::Level levels[] = {SimdKernels::Level::AVX2, SimdKernels::Level::AVX512};
+    for (auto level : levels) {
+        if (!SimdKernels::isSupported(level)) {
+            continue;
+        }
+        TechnicalIndicator::IndicatorColumns vectorized;
+        indicator.computeIndicators(store, vectorized, level);
+        for (size_t i = 0; i < store.size(); ++i) {
+            assert(approxEqual(scalar.sma_20[i], vectorized.sma_20[i], 1e-12));
+            assert(approxEqual(scalar.sma_50[i], vectorized.sma_50[i], 1e-12));
+            assert(approxEqual(scalar.rsi[i], vectorized.rsi[i], 1e-12));
+            assert(approxEqual(scalar.macd[i], vectorized.macd[i], 1e-12));
+            assert(approxEqual(scalar.macd_signal[i], vectorized.macd_signal[i], 1e-12));
+            assert(scalar.signal[i] == vectorized.signal[i]);
+        }
+    }
+    
+    std::cout << "PASSED (" << SimdKernels::levelName(SimdKernels::activeLevel()) << ")\n";
+}
+
+// Test 9: Incremental Indicator vs From-Scratch Recomputation
+void testIncrementalIndicator() {
+    std::cout << "Test 9: Incremental Indicator... ";
+    
+    TechnicalIndicator indicator;
+    IncrementalIndicator incremental("INC");
+    TechnicalIndicator::StockData stock;
+    stock.symbol = "INC";
+    
+    double avgGain = 0.0, avgLoss = 0.0;
+    double ema12 = 0.0, ema26 = 0.0, signal = 0.0;
+    
+    for (int i = 0; i < 500; ++i) {
+        double price = 100.0 + std::sin(i * 0.17) * 8.0 + i * 0.02;
+        stock.prices.push_back(price);
+        auto streamed = incremental.update(price);
+        
+        // Reference recurrences recomputed alongside the stream
+        if (i == 0) {
+            ema12 = ema26 = price;
+        } else {
+            double change = price - stock.prices[i - 1];
+            double gain = change > 0 ? change : 0.0;
+            double loss = change > 0 ? 0.0 : -change;
+            if (i <= 14) {
+                avgGain += gain / 14;
+                avgLoss += loss / 14;
+            } else {
+                avgGain = (avgGain * 13 + gain) / 14;
+                avgLoss = (avgLoss * 13 + loss) / 14;
+            }
+            ema12 += (price - ema12) * (2.0 / 13);
+            ema26 += (price - ema26) * (2.0 / 27);
+            if (i == 25) signal = ema12 - ema26;
+            else if (i > 25) signal += (ema12 - ema26 - signal) * 0.2;
+        }
+        
+        auto batch = indicator.computeIndicators(stock);
+        assert(TechnicalIndicator::symbolName(streamed) == "INC");
+        assert(approxEqual(streamed.sma_20, batch.sma_20, 1e-9));
+        assert(approxEqual(streamed.sma_50, batch.sma_50, 1e-9));
+        
+        if (i >= 14) {
+            double expectedRsi = avgLoss == 0.0 ? 100.0 : 100.0 - 100.0 / (1.0 + avgGain / avgLoss);
+            assert(approxEqual(streamed.rsi, expectedRsi, 1e-9));
+        } else {
+            assert(streamed.rsi == 50.0);
+        }
+        if (i >= 25) {
+            assert(approxEqual(streamed.macd, ema12 - ema26, 1e-9));
+            assert(approxEqual(streamed.macd_signal, signal, 1e-9));
+        } else {
+            assert(streamed.macd == 0.0);
+        }
+        assert(streamed.signal == TechnicalIndicator::Signal::Buy ||
+               streamed.signal == TechnicalIndicator::Signal::Sell ||
+               streamed.signal == TechnicalIndicator::Signal::Hold);
+    }
+    
+    assert(incremental.count() == 500);
+    incremental.reset();
+    assert(incremental.count() == 0);
+    assert(incremental.result().signal == TechnicalIndicator::Signal::Hold);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 10: Full-Series Output Matches the Streaming Engine Bar by Bar
+void testIndicatorSeries() {
+    std::cout << "Test 10: Full-Series Indicators... ";
+    
+    TechnicalIndicator indicator;
+    IncrementalIndicator incremental;
+    TechnicalIndicator::StockData stock;
+    stock.symbol = "SERIES";
+    for (int i = 0; i < 1000; ++i) {
+        stock.prices.push_back(80.0 + std::cos(i * 0.05) * 10.0 + (i % 9) * 0.3);
+    }
+    
+    size_t n = stock.prices.size();
+    std::vector<double> sma20(n), sma50(n), rsi(n), macd(n), signal(n);
+    TechnicalIndicator::IndicatorSeries series{sma20.data(), sma50.data(), rsi.data(),
+                                               macd.data(), signal.data()};
+    indicator.computeIndicatorSeries(stock, series);
+    
+    for (size_t t = 0; t < n; ++t) {
+        incremental.push(stock.prices[t]);
+        assert(approxEqual(sma20[t], incremental.sma20(), 1e-9));
+        assert(approxEqual(sma50[t], incremental.sma50(), 1e-9));
+        assert(approxEqual(rsi[t], incremental.rsi(), 1e-9));
+        assert(approxEqual(macd[t], incremental.macd(), 1e-9));
+        assert(approxEqual(signal[t], incremental.macdSignal(), 1e-9));
+    }
+    
+    // SMAs share the snapshot definition, so the last bar must agree
+    auto snapshot = indicator.computeIndicators(stock);
+    assert(approxEqual(sma20[n - 1], snapshot.sma_20, 1e-9));
+    assert(approxEqual(sma50[n - 1], snapshot.sma_50, 1e-9));
+    
+    // Long history that collapses from a high price level: the running sums
+    // are re-summed periodically, so rounding picked up at the old level
+    // does not survive into the last bar
+    std::vector<double> longPrices(500017);
+    for (size_t t = 0; t < longPrices.size(); ++t) {
+        double level = t < 250000 ? 1.0e8 : 1.0;
+        longPrices[t] = level * (1.0 + std::sin(t * 0.013) * 0.5) + (t % 17) * 0.037;
+    }
+    size_t m = longPrices.size();
+    std::vector<double> long20(m), long50(m), longRsi(m), longMacd(m), longSignal(m);
+    indicator.computeIndicatorSeries(longPrices.data(), m, {long20.data(), long50.data(),
+                                                            longRsi.data(), longMacd.data(),
+                                                            longSignal.data()});
+    double fresh20 = indicator.calculateSMA(longPrices.data(), m, 20);
+    double fresh50 = indicator.calculateSMA(longPrices.data(), m, 50);
+    assert(std::abs(long20[m - 1] - fresh20) <= std::abs(fresh20) * 1e-14);
+    assert(std::abs(long50[m - 1] - fresh50) <= std::abs(fresh50) * 1e-14);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 11: Lock-Free Ring Queues (ordering, bulk, MPMC totals, stop wakeup)
+void testRingQueues() {
+    std::cout << "Test 11: Lock-Free Ring Queues... ";
+    
+    const int kItems = 200000;
+    
+    SpscRingQueue<int> spsc(1000);
+    assert(spsc.capacity() == 1024);
+    std::thread producer([&spsc] {
+        int chunk[37];
+        for (int i = 0; i < kItems; i += 37) {
+            int count = std::min(37, kItems - i);
+            for (int j = 0; j < count; ++j) chunk[j] = i + j;
+            spsc.pushBulk(chunk, count);
+        }
+    });
+    int expected = 0;
+    int buffer[64];
+    while (expected < kItems) {
+        size_t n = spsc.waitPopBulk(buffer, 64, std::chrono::seconds(5));
+        assert(n > 0);
+        for (size_t j = 0; j < n; ++j) {
+            assert(buffer[j] == expected++);
+        }
+    }
+    producer.join();
+    assert(spsc.empty());
+    
+    MpmcRingQueue<long> mpmc(256);
+    std::atomic<long> consumedSum{0};
+    std::atomic<int> consumedCount{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 3; ++p) {
+        threads.emplace_back([&mpmc, p] {
+            for (int i = 0; i < kItems; ++i) {
+                mpmc.push(static_cast<long>(p) * kItems + i);
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            long items[16];
+            while (consumedCount.load() < 3 * kItems) {
+                size_t n = mpmc.waitPopBulk(items, 16, std::chrono::milliseconds(10));
+                for (size_t j = 0; j < n; ++j) consumedSum += items[j];
+                consumedCount += static_cast<int>(n);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    long total = 3L * kItems;
+    assert(consumedCount.load() == total);
+    assert(consumedSum.load() == total * (total - 1) / 2);
+    
+    // stop() must release a consumer blocked on an empty queue
+    MpmcRingQueue<int> idle(8);
+    std::thread waiter([&idle] {
+        int item;
+        size_t n = idle.waitPopBulk(&item, 1, std::chrono::seconds(30));
+        assert(n == 0);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto stopStart = std::chrono::steady_clock::now();
+    idle.stop();
+    waiter.join();
+    assert(std::chrono::steady_clock::now() - stopStart < std::chrono::seconds(5));
+    
+    // Zero-count bulk calls return at once on a queue that has both items
+    // and free slots
+    ThreadSafeQueue<int> locked;
+    SpscRingQueue<int> spscZero(16);
+    MpmcRingQueue<int> mpmcZero(16);
+    for (ConcurrentQueue<int>* queue : std::initializer_list<ConcurrentQueue<int>*>{
+             &locked, &spscZero, &mpmcZero}) {
+        queue->push(1);
+        int item = 0;
+        auto zeroStart = std::chrono::steady_clock::now();
+        assert(queue->popBulk(&item, 0) == 0);
+        assert(queue->waitPopBulk(&item, 0, std::chrono::seconds(5)) == 0);
+        assert(queue->pushBulk(&item, 0) == 0);
+        assert(std::chrono::steady_clock::now() - zeroStart < std::chrono::seconds(1));
+        assert(queue->size() == 1 && queue->tryPop() == 1);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 12: Work-Stealing Pool on Skewed Series Lengths
+void testWorkStealingPool() {
+    std::cout << "Test 12: Work-Stealing Pool... ";
+    
+    // A single expensive item must not be merged into a neighbouring chunk
+    std::vector<size_t> costs = {1, 1, 1, 100, 1, 1, 1, 1};
+    auto bounds = WorkStealingPool::partitionByCost(costs, 4);
+    assert(bounds.front() == 0 && bounds.back() == costs.size());
+    bool isolated = false;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        isolated = isolated || (bounds[i] == 3 && bounds[i + 1] == 4);
+    }
+    assert(isolated);
+    
+    WorkStealingPool pool(3);
+    auto future = pool.submitWithFuture([] { return 42; });
+    assert(future.get() == 42);
+    
+    TechnicalIndicator indicator;
+    std::vector<TechnicalIndicator::StockData> stocks(64);
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        stocks[i].symbol = "SKEW" + std::to_string(i);
+        size_t length = (i < 4) ? 3000 + i : 40 + i * 3;
+        for (size_t j = 0; j < length; ++j) {
+            stocks[i].prices.push_back(100.0 + std::sin((i + 1) * j * 0.01) * 3.0);
+        }
+    }
+    
+    std::vector<std::vector<double>> expected(stocks.size() * 5), actual(stocks.size() * 5);
+    std::vector<TechnicalIndicator::IndicatorSeries> expectedOut, actualOut;
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        for (size_t k = 0; k < 5; ++k) {
+            expected[i * 5 + k].resize(stocks[i].prices.size());
+            actual[i * 5 + k].resize(stocks[i].prices.size());
+        }
+        expectedOut.push_back({expected[i * 5].data(), expected[i * 5 + 1].data(),
+                               expected[i * 5 + 2].data(), expected[i * 5 + 3].data(),
+                               expected[i * 5 + 4].data()});
+        actualOut.push_back({actual[i * 5].data(), actual[i * 5 + 1].data(),
+                             actual[i * 5 + 2].data(), actual[i * 5 + 3].data(),
+                             actual[i * 5 + 4].data()});
+    }
+    
+    indicator.computeIndicatorSeriesParallel(stocks, expectedOut);
+    for (int round = 0; round < 3; ++round) {
+        indicator.computeIndicatorSeriesParallel(stocks, actualOut, pool);
+        assert(actual == expected);
+    }
+    
+    auto ompResults = indicator.computeIndicatorsParallel(stocks);
+    auto poolResults = indicator.computeIndicatorsParallel(stocks, pool);
+    assert(ompResults.size() == poolResults.size());
+    for (size_t i = 0; i < ompResults.size(); ++i) {
+        assert(ompResults[i].symbolId == poolResults[i].symbolId);
+        assert(ompResults[i].signal == poolResults[i].signal);
+        assert(approxEqual(ompResults[i].rsi, poolResults[i].rsi, 1e-12));
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 13: Binary History Round Trip and Zero-Copy Analysis
+void testBinaryHistory() {
+    std::cout << "Test 13: Binary History mmap Round Trip... ";
+    
+    std::vector<TechnicalIndicator::StockData> stocks;
+    for (int i = 0; i < 25; ++i) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = "BIN" + std::to_string(i);
+        for (int j = 0; j < 37 * i; ++j) {
+            stock.prices.push_back(50.0 + i + std::sin(j * 0.2));
+            stock.volumes.push_back(1000.0 * j);
+            stock.timestamps.push_back(j);
+        }
+        stocks.push_back(stock);
+    }
+    
+    const std::string path = "test_history.bin";
+    BinaryHistory::write(path, stocks);
+    
+    {
+        MappedHistory history(path);
+        assert(history.size() == stocks.size());
+        assert(history.find("BIN7") == 7);
+        assert(history.find("MISSING") == history.size());
+        
+        TechnicalIndicator indicator;
+        auto fromViews = indicator.computeIndicatorsParallel(history.views());
+        for (size_t i = 0; i < stocks.size(); ++i) {
+            auto view = history.series(i);
+            assert(view.symbol == stocks[i].symbol);
+            assert(view.symbolId == SymbolTable::global().find(stocks[i].symbol));
+            assert(view.length == stocks[i].prices.size());
+            assert(reinterpret_cast<uintptr_t>(view.prices) % BinaryHistory::kColumnAlignment == 0);
+            for (size_t j = 0; j < view.length; ++j) {
+                assert(view.prices[j] == stocks[i].prices[j]);
+                assert(view.volumes[j] == stocks[i].volumes[j]);
+                assert(view.timestamps[j] == stocks[i].timestamps[j]);
+            }
+            
+            auto expected = indicator.computeIndicators(stocks[i]);
+            assert(fromViews[i].symbolId == expected.symbolId);
+            assert(fromViews[i].signal == expected.signal);
+            if (view.length > 0) {
+                assert(approxEqual(fromViews[i].rsi, expected.rsi, 1e-12));
+            }
+        }
+    }
+    
+    // A truncated file must be rejected rather than read out of bounds
+    std::FILE* truncated = std::fopen(path.c_str(), "wb");
+    const char garbage[80] = "STKHIST1";
+    std::fwrite(garbage, 1, sizeof(garbage), truncated);
+    std::fclose(truncated);
+    bool rejected = false;
+    try {
+        MappedHistory broken(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    // Counts and offsets chosen so unchecked 64-bit arithmetic wraps back
+    // inside the file must be rejected too
+    using Entry = BinaryHistory::DirectoryEntry;
+    const uint64_t entry0 = sizeof(BinaryHistory::FileHeader);
+    const std::vector<std::pair<uint64_t, uint64_t>> patches = {
+        {offsetof(BinaryHistory::FileHeader, numSymbols), uint64_t(1) << 58},
+        {offsetof(BinaryHistory::FileHeader, directoryOffset), sizeof(BinaryHistory::FileHeader) + 4},
+        {entry0 + offsetof(Entry, length), (uint64_t(1) << 61) + 1},
+        {entry0 + offsetof(Entry, pricesOffset), ~uint64_t(0) - 63},
+        {entry0 + offsetof(Entry, timestampsOffset), ~uint64_t(0) - 63},
+    };
+    for (const auto& patch : patches) {
+        BinaryHistory::write(path, stocks);
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(patch.first));
+            file.write(reinterpret_cast<const char*>(&patch.second), sizeof(patch.second));
+        }
+        rejected = false;
+        try {
+            MappedHistory broken(path);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected);
+    }
+    std::remove(path.c_str());
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 14: Parallel CSV Ingestion
+void testCsvIngestion() {
+    std::cout << "Test 14: Parallel CSV Ingestion... ";
+    
+    const std::string path = "test_ingest.csv";
+    StockDataFetcher fetcher;
+    StockDataFetcher::IngestStats stats;
+    
+    // Header, CRLF endings, ISO dates, one malformed row, interleaved
+    // symbols and an out-of-order bar
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "symbol,date,close,volume\r\n"
+            << "AAA,2024-01-02,10.5,100\r\n"
+            << "BBB,2024-01-02,20.25,200\r\n"
+            << "AAA,2024-01-04,11.5,110\r\n"
+            << "BBB,2024-01-03,not-a-price,0\r\n"
+            << "AAA,2024-01-03,11.0,105\r\n"
+            << "BBB,2024-01-04,21.0,210";
+    }
+    auto small = fetcher.loadCsv(path, &stats);
+    assert(small.size() == 2);
+    assert(stats.rows == 5 && stats.skippedRows == 1 && stats.symbols == 2);
+    assert(small[0].symbol == "AAA" && small[1].symbol == "BBB");
+    assert(small[0].symbolId == SymbolTable::global().find("AAA") &&
+           small[1].symbolId == SymbolTable::global().find("BBB"));
+    assert(small[0].prices.size() == 3 && small[1].prices.size() == 2);
+    assert(small[0].timestamps[0] == 20240102.0 && small[0].timestamps[2] == 20240104.0);
+    assert(small[0].prices[1] == 11.0 && small[0].volumes[1] == 105.0);
+    assert(small[1].prices[0] == 20.25 && small[1].prices[1] == 21.0);
+    
+    // Large enough to be split into several chunks; every symbol must come
+    // back whole and in order regardless of where the cuts fall
+    const int kSymbols = 37;
+    const int kBars = 2500;
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int day = 0; day < kBars; ++day) {
+            for (int s = 0; s < kSymbols; ++s) {
+                out << "SYM" << s << "," << day << "," << (s + day * 0.25) << ","
+                    << (day * 10 + s) << "\n";
+            }
+        }
+    }
+    auto large = fetcher.loadCsv(path, &stats);
+    assert(stats.rows == static_cast<size_t>(kSymbols) * kBars && stats.skippedRows == 0);
+    assert(large.size() == static_cast<size_t>(kSymbols));
+    for (int s = 0; s < kSymbols; ++s) {
+        assert(large[s].symbol == "SYM" + std::to_string(s));
+        assert(large[s].prices.size() == static_cast<size_t>(kBars));
+        for (int day = 0; day < kBars; ++day) {
+            assert(large[s].timestamps[day] == day);
+            assert(large[s].prices[day] == s + day * 0.25);
+            assert(large[s].volumes[day] == day * 10 + s);
+        }
+    }
+    std::remove(path.c_str());
+    
+    bool rejected = false;
+    try {
+        fetcher.loadCsv("does_not_exist.csv");
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    // Negative or repeated column indices are rejected before any parsing
+    StockDataFetcher::CsvLayout negative;
+    negative.volumeColumn = -1;
+    StockDataFetcher::CsvLayout repeated;
+    repeated.priceColumn = repeated.symbolColumn;
+    for (const auto& layout : {negative, repeated}) {
+        rejected = false;
+        try {
+            fetcher.loadCsv("does_not_exist.csv", layout);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        assert(rejected);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 15: Interned Symbols and Plain-Data Results
+void testSymbolInterning() {
+    std::cout << "Test 15: Interned Symbols and POD Results... ";
+    
+    SymbolTable table;
+    SymbolTable::Id a = table.intern("AAPL");
+    SymbolTable::Id b = table.intern("MSFT");
+    assert(a == 0 && b == 1);
+    assert(table.intern(std::string("AAPL")) == a);
+    assert(table.find("MSFT") == b);
+    assert(table.find("NONE") == SymbolTable::kInvalidId);
+    assert(table.name(b) == "MSFT");
+    assert(table.name(42).empty());
+    
+    // Concurrent interning of overlapping symbol sets must agree on IDs
+    std::vector<std::thread> threads;
+    std::vector<std::vector<SymbolTable::Id>> ids(4);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&table, &ids, t] {
+            for (int i = 0; i < 500; ++i) {
+                ids[t].push_back(table.intern("T" + std::to_string((i * (t + 1)) % 500)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(table.size() == 502);
+    for (int t = 0; t < 4; ++t) {
+        for (int i = 0; i < 500; ++i) {
+            assert(table.name(ids[t][i]) == "T" + std::to_string((i * (t + 1)) % 500));
+        }
+    }
+    
+    // Results round-trip through raw bytes
+    TechnicalIndicator indicator;
+    TechnicalIndicator::StockData stock;
+    stock.symbol = "POD";
+    for (int i = 0; i < 60; ++i) {
+        stock.prices.push_back(100.0 + i);
+    }
+    auto result = indicator.computeIndicators(stock);
+    unsigned char bytes[sizeof(result)];
+    std::memcpy(bytes, &result, sizeof(result));
+    TechnicalIndicator::IndicatorResult copy;
+    std::memcpy(&copy, bytes, sizeof(copy));
+    assert(TechnicalIndicator::symbolName(copy) == "POD");
+    assert(copy.signal == result.signal && copy.rsi == result.rsi);
+    
+    // A carried ID is used as is: the kernels never look the symbol up
+    TechnicalIndicator::StockData carried = stock;
+    carried.symbol = "CARRIED_NOT_INTERNED";
+    carried.symbolId = result.symbolId;
+    assert(indicator.computeIndicators(carried).symbolId == result.symbolId);
+    assert(indicator.computeExtendedIndicators(carried).symbolId == result.symbolId);
+    assert((IndicatorPipeline<SMA<20>>::compute(carried).symbolId == result.symbolId));
+    assert(Backtester().run(TechnicalIndicator::makeView(carried), Backtester::Params()).symbolId ==
+           result.symbolId);
+    assert(SymbolTable::global().find(carried.symbol) == SymbolTable::kInvalidId);
+    
+    // Ingest assigns IDs once
+    std::vector<TechnicalIndicator::StockData> unassigned(2, stock);
+    unassigned[1].symbol = "POD2";
+    TechnicalIndicator::internSymbols(unassigned);
+    assert(unassigned[0].symbolId == result.symbolId &&
+           unassigned[1].symbolId == SymbolTable::global().find("POD2"));
+    auto store = ColumnarPriceStore::fromStockData({stock});
+    assert(store.symbolId(0) == result.symbolId);
+    StockDataFetcher fetcher;
+    auto fetched = fetcher.fetchStockData("FETCHED");
+    assert(fetched.symbolId == SymbolTable::global().find("FETCHED"));
+    
+    std::cout << "PASSED\n";
+}
+
+// Queue payload that counts its copies, to check bulk pushes copy at most
+// once
+struct CopyCounted {
+    static inline int copies = 0;
+    int value = 0;
+    CopyCounted() = default;
+    explicit CopyCounted(int v) : value(v) {}
+    CopyCounted(const CopyCounted& other) : value(other.value) { ++copies; }
+    CopyCounted& operator=(const CopyCounted& other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    CopyCounted(CopyCounted&&) = default;
+    CopyCounted& operator=(CopyCounted&&) = default;
+};
+
+// Test 16: Latency Histogram
+void testLatencyHistogram() {
+    std::cout << "Test 16: Latency Histogram... ";
+    
+    // Buckets tile the value range without gaps and every value lands in
+    // the bucket whose bounds contain it
+    for (size_t i = 0; i + 1 < LatencyHistogram::kBuckets; ++i) {
+        assert(LatencyHistogram::bucketUpperBound(i) + 1 == LatencyHistogram::bucketLowerBound(i + 1));
+    }
+    for (uint64_t v : {0ULL, 1ULL, 31ULL, 32ULL, 33ULL, 1000ULL, 123456789ULL, ~0ULL}) {
+        size_t index = LatencyHistogram::bucketIndex(v);
+        assert(index < LatencyHistogram::kBuckets);
+        assert(LatencyHistogram::bucketLowerBound(index) <= v);
+        assert(v <= LatencyHistogram::bucketUpperBound(index));
+    }
+    
+    LatencyHistogram histogram;
+    assert(histogram.snapshot().quantile(0.5) == 0);
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        histogram.record(v * 1000);
+    }
+    auto snapshot = histogram.snapshot();
+    assert(snapshot.count == 100000);
+    assert(snapshot.max == 100000000);
+    for (double q : {0.5, 0.9, 0.99, 0.999}) {
+        double exact = q * 100000 * 1000;
+        assert(std::abs(snapshot.quantile(q) - exact) / exact < 0.035);
+    }
+    assert(snapshot.quantile(1.0) == snapshot.max);
+    
+    // Per-thread histograms merged on demand
+    LatencyHistogram a, b;
+    std::thread writerA([&a] { for (int i = 0; i < 50000; ++i) a.record(100); });
+    std::thread writerB([&b] { for (int i = 0; i < 50000; ++i) b.record(1000000); });
+    writerA.join();
+    writerB.join();
+    auto merged = a.snapshot();
+    merged.merge(b.snapshot());
+    assert(merged.count == 100000);
+    assert(std::abs(static_cast<double>(merged.quantile(0.25)) - 100) / 100 < 0.035);
+    assert(std::abs(static_cast<double>(merged.quantile(0.75)) - 1e6) / 1e6 < 0.035);
+    assert(approxEqual(merged.mean(), (100.0 + 1e6) / 2, 1e-6));
+    
+    histogram.reset();
+    assert(histogram.snapshot().count == 0 && histogram.snapshot().max == 0);
+    
+    // Queue wait is enqueue to dequeue: idle time on an empty queue is not
+    // recorded, and items that sat 20 ms report at least that long
+    for (int kind = 0; kind < 2; ++kind) {
+        using Stamped = TimestampedQueue<int>::Stamped;
+        LatencyHistogram waits;
+        std::unique_ptr<ConcurrentQueue<Stamped>> inner;
+        if (kind == 0) {
+            inner = std::make_unique<ThreadSafeQueue<Stamped>>();
+        } else {
+            inner = std::make_unique<MpmcRingQueue<Stamped>>(256);
+        }
+        TimestampedQueue<int> queue(std::move(inner), waits);
+        
+        int out[200];
+        assert(queue.waitPopBulk(out, 200, std::chrono::milliseconds(5)) == 0);
+        assert(waits.snapshot().count == 0);
+        
+        std::vector<int> items(150);
+        for (int i = 0; i < 150; ++i) {
+            items[i] = i;
+        }
+        assert(queue.pushBulk(items.data(), items.size()) == 150);
+        queue.push(150);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        size_t popped = queue.waitPopBulk(out, 200, std::chrono::seconds(1));
+        assert(popped == 151 && queue.empty());
+        for (int i = 0; i <= 150; ++i) {
+            assert(out[i] == i);
+        }
+        auto waited = waits.snapshot();
+        assert(waited.count == 151);
+        assert(waited.quantile(0.0) >= 19000000);
+        
+        queue.push(7);
+        auto single = queue.tryPop();
+        assert(single && *single == 7 && waits.snapshot().count == 152);
+    }
+    
+    // pushBulk copies each item once on its way through the stamping buffer
+    // and pushBulkMove not at all
+    for (int kind = 0; kind < 2; ++kind) {
+        using Stamped = TimestampedQueue<CopyCounted>::Stamped;
+        LatencyHistogram waits;
+        std::unique_ptr<ConcurrentQueue<Stamped>> inner;
+        if (kind == 0) {
+            inner = std::make_unique<ThreadSafeQueue<Stamped>>();
+        } else {
+            inner = std::make_unique<MpmcRingQueue<Stamped>>(256);
+        }
+        TimestampedQueue<CopyCounted> queue(std::move(inner), waits);
+        
+        std::vector<CopyCounted> items;
+        for (int i = 0; i < 100; ++i) {
+            items.emplace_back(i);
+        }
+        std::vector<CopyCounted> out(100);
+        CopyCounted::copies = 0;
+        assert(queue.pushBulk(items.data(), items.size()) == 100);
+        assert(CopyCounted::copies == 100);
+        assert(queue.popBulk(out.data(), out.size()) == 100);
+        assert(queue.pushBulkMove(items.data(), items.size()) == 100);
+        assert(queue.popBulk(out.data(), out.size()) == 100);
+        assert(CopyCounted::copies == 100 && out[99].value == 99);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 17: Timer Queue
+void testTimerQueue() {
+    std::cout << "Test 17: Timer Queue... ";
+    
+    using Clock = TimerQueue::Clock;
+    TimerQueue timers;
+    std::atomic<int> fast(0), slow(0), once(0), cancelled(0);
+    
+    // Two independent sub-millisecond and millisecond schedules, a one-shot
+    // and a timer cancelled before it ever fires
+    timers.schedule(std::chrono::microseconds(500), [&fast] { ++fast; });
+    timers.schedule(std::chrono::milliseconds(10), [&slow] { ++slow; });
+    timers.scheduleOnce(std::chrono::milliseconds(5), [&once] { ++once; });
+    auto dropped = timers.scheduleOnce(std::chrono::milliseconds(1), [&cancelled] { ++cancelled; });
+    assert(timers.cancel(dropped));
+    assert(!timers.cancel(dropped));
+    
+    // A timer can cancel itself from its own callback
+    TimerQueue::TimerId selfCancelling = 0;
+    std::atomic<int> selfRuns(0);
+    selfCancelling = timers.schedule(std::chrono::milliseconds(1), [&] {
+        if (++selfRuns == 3) {
+            timers.cancel(selfCancelling);
+        }
+    });
+    
+    auto loopStart = Clock::now();
+    std::thread loop([&timers] { timers.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    // A timer added from another thread with an earlier deadline than
+    // anything pending must wake the loop
+    std::atomic<bool> lateFired(false);
+    auto scheduledAt = Clock::now();
+    std::atomic<int64_t> lateDelayUs(0);
+    timers.scheduleOnce(std::chrono::milliseconds(2), [&] {
+        lateDelayUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - scheduledAt).count();
+        lateFired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(lateFired);
+    assert(lateDelayUs >= 2000);
+    
+    // stop() must return run() promptly even with a far deadline pending
+    timers.scheduleOnce(std::chrono::hours(1), [] {});
+    auto stopStart = Clock::now();
+    timers.stop();
+    loop.join();
+    auto stopLatency = Clock::now() - stopStart;
+    assert(stopLatency < std::chrono::milliseconds(50));
+    
+    // Fixed rate with missed ticks skipped: never more runs than periods
+    auto elapsed = stopStart - loopStart;
+    assert(fast > 20);
+    assert(slow >= 5 && slow <= elapsed / std::chrono::milliseconds(10) + 1);
+    assert(once == 1);
+    assert(cancelled == 0);
+    assert(selfRuns == 3);
+    
+    // Timers survive stop(); reset() lets run() resume them
+    int before = slow;
+    timers.reset();
+    std::thread again([&timers] { timers.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    timers.stop();
+    again.join();
+    assert(slow > before);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 18: Snapshot Cache Publication
+void testSnapshotCache() {
+    std::cout << "Test 18: Snapshot Cache Publication... ";
+    using Clock = std::chrono::steady_clock;
+    
+    auto makeStock = [](const std::string& symbol, size_t length, double start) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = symbol;
+        for (size_t i = 0; i < length; ++i) {
+            stock.prices.push_back(100.0 + std::sin(i * 0.1) * 5.0);
+            stock.volumes.push_back(1000.0);
+            stock.timestamps.push_back(start + i);
+        }
+        return stock;
+    };
+    
+    Scheduler scheduler(3600);
+    scheduler.addStockData(makeStock("SNAPA", 100, 0));
+    scheduler.addStockData(makeStock("SNAPB", 100, 0));
+    auto initial = scheduler.snapshot();
+    assert(initial->version == 2);
+    assert(initial->series.size() == 2);
+    
+    // An identical update publishes nothing
+    scheduler.addStockData(makeStock("SNAPA", 100, 0));
+    auto same = scheduler.snapshot();
+    assert(same == initial);
+    
+    // A long analysis cycle must not delay writers
+    std::atomic<bool> inCycle(false);
+    std::atomic<size_t> cycleLength(0);
+    scheduler.setAnalysisCallback(
+        [&inCycle, &cycleLength](const std::vector<TechnicalIndicator::PriceSeriesView>& views) {
+            inCycle = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            cycleLength = views[0].length;
+        });
+    scheduler.start();
+    while (!inCycle) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    Clock::duration slowest{};
+    for (int i = 0; i < 20; ++i) {
+        auto writeStart = Clock::now();
+        scheduler.addStockData(makeStock("SNAPA", 1, 100 + i));
+        slowest = std::max(slowest, Clock::now() - writeStart);
+    }
+    assert(slowest < std::chrono::milliseconds(50));
+    
+    auto latest = scheduler.snapshot();
+    assert(latest->version == same->version + 20);
+    const TechnicalIndicator::StockData* merged = latest->find("SNAPA");
+    assert(merged && merged->prices.size() == 120);
+    assert(latest->series[1] == initial->series[1]);
+    // Readers holding the older version still see it unchanged
+    assert(initial->find("SNAPA")->prices.size() == 100);
+    
+    scheduler.stop();
+    // The cycle analyzed the version it started with
+    assert(cycleLength == 100);
+    
+    // A batch load publishes a single version
+    std::vector<TechnicalIndicator::StockData> bulk;
+    for (int i = 0; i < 100; ++i) {
+        bulk.push_back(makeStock("BULK" + std::to_string(i), 60, 0));
+    }
+    bulk.push_back(makeStock("SNAPB", 100, 0));  // unchanged
+    auto beforeBulk = scheduler.snapshot();
+    scheduler.addStockData(bulk);
+    auto afterBulk = scheduler.snapshot();
+    assert(afterBulk->version == beforeBulk->version + 1);
+    assert(afterBulk->series.size() == beforeBulk->series.size() + 100);
+    assert(afterBulk->find("BULK99")->prices.size() == 60);
+    assert(afterBulk->series[1] == beforeBulk->series[1]);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 19: Bounded Per-Symbol Retention
+void testBoundedRetention() {
+    std::cout << "Test 19: Bounded Per-Symbol Retention... ";
+    
+    auto makeBars = [](const std::string& symbol, double firstTimestamp, size_t length) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = symbol;
+        for (size_t i = 0; i < length; ++i) {
+            double t = firstTimestamp + i;
+            stock.prices.push_back(100.0 + t);
+            stock.volumes.push_back(t);
+            stock.timestamps.push_back(t);
+        }
+        return stock;
+    };
+    
+    Scheduler scheduler(3600);
+    scheduler.setRetention(60);
+    
+    // An oversized initial history is trimmed to its tail
+    scheduler.addStockData(makeBars("RETA", 0, 200));
+    const TechnicalIndicator::StockData* stock = scheduler.snapshot()->find("RETA");
+    assert(stock->prices.size() == 60);
+    assert(stock->timestamps.front() == 140 && stock->timestamps.back() == 199);
+    
+    // A long stream of appends stays bounded and keyed by symbol
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.addStockData(makeBars("RETA", 200 + i * 5, 5));
+    }
+    auto latest = scheduler.snapshot();
+    assert(latest->series.size() == 1);
+    stock = latest->find("RETA");
+    assert(stock->prices.size() == 60 && stock->volumes.size() == 60);
+    assert(stock->timestamps.front() == 5140 && stock->timestamps.back() == 5199);
+    for (size_t i = 0; i < stock->prices.size(); ++i) {
+        assert(stock->prices[i] == 100.0 + stock->timestamps[i]);
+        assert(stock->volumes[i] == stock->timestamps[i]);
+    }
+    
+    // Upsert: a correction replaces the bars from its timestamp onward
+    TechnicalIndicator::StockData correction = makeBars("RETA", 5198, 1);
+    correction.prices[0] = 1.0;
+    scheduler.addStockData(correction);
+    stock = scheduler.snapshot()->find("RETA");
+    assert(stock->prices.size() == 59);
+    assert(stock->timestamps.back() == 5198 && stock->prices.back() == 1.0);
+    
+    // Retention never drops below the longest indicator window
+    scheduler.setRetention(10);
+    scheduler.addStockData(makeBars("RETB", 0, 100));
+    assert(scheduler.snapshot()->find("RETB")->prices.size() == 50);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 20: Dirty-Set Cycles and Result Dedup
+void testDirtyTracking() {
+    std::cout << "Test 20: Dirty-Set Cycles and Result Dedup... ";
+    using Clock = std::chrono::steady_clock;
+    
+    auto makeBars = [](const std::string& symbol, double firstTimestamp, size_t length) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = symbol;
+        for (size_t i = 0; i < length; ++i) {
+            double t = firstTimestamp + i;
+            stock.prices.push_back(100.0 + std::sin(t * 0.3) * 10.0);
+            stock.volumes.push_back(1000.0);
+            stock.timestamps.push_back(t);
+        }
+        return stock;
+    };
+    
+    TechnicalIndicator indicator;
+    Scheduler scheduler(std::chrono::milliseconds(20), Scheduler::QueueKind::Mpmc);
+    std::atomic<int> calls(0);
+    std::atomic<size_t> analyzed(0);
+    std::atomic<size_t> lastBatch(0);
+    scheduler.setAnalysisCallback(
+        [&](const std::vector<TechnicalIndicator::PriceSeriesView>& views) {
+            auto results = indicator.computeIndicatorsParallel(views);
+            scheduler.getNotificationQueue().pushBulk(results.data(), results.size());
+            lastBatch = views.size();
+            analyzed += views.size();
+            ++calls;
+        });
+    std::atomic<int> notified(0);
+    scheduler.setNotificationCallback(
+        [&notified](const TechnicalIndicator::IndicatorResult&) { ++notified; });
+    
+    for (const char* symbol : {"DRTA", "DRTB", "DRTC", "DRTD"}) {
+        scheduler.addStockData(makeBars(symbol, 0, 80));
+    }
+    
+    auto waitFor = [](const std::function<bool()>& done) {
+        auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (!done() && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done();
+    };
+    
+    scheduler.start();
+    // First cycle: every symbol is dirty
+    assert(waitFor([&] { return calls >= 1; }));
+    assert(analyzed == 4 && lastBatch == 4);
+    
+    // Idle cycles recompute nothing
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(calls == 1 && analyzed == 4);
+    
+    // A no-op update does not dirty the symbol; a new bar does
+    scheduler.addStockData(makeBars("DRTB", 0, 80));
+    scheduler.addStockData(makeBars("DRTC", 80, 1));
+    assert(waitFor([&] { return calls >= 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    assert(calls == 2 && analyzed == 5 && lastBatch == 1);
+    
+    // Results for every symbol stay available; a repeated result is not
+    // notified again
+    assert(waitFor([&] { return scheduler.latestResults().size() == 4; }));
+    TechnicalIndicator::IndicatorResult repeat = scheduler.latestResults()[0];
+    repeat.signal = TechnicalIndicator::Signal::Buy;
+    repeat.signal_strength = -1.0;
+    int before = notified;
+    scheduler.getNotificationQueue().push(repeat);
+    scheduler.getNotificationQueue().push(repeat);
+    assert(waitFor([&] { return notified == before + 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(notified == before + 1);
+    
+    // Series too short for SMA50 have a finite strength, so their repeats
+    // are dropped as well
+    TechnicalIndicator::IndicatorResult shortResult = indicator.computeIndicators(makeBars("DRTS", 0, 30));
+    assert(shortResult.sma_50 == 0.0 && std::isfinite(shortResult.signal_strength));
+    assert(shortResult == indicator.computeIndicators(makeBars("DRTS", 0, 30)));
+    shortResult.signal = TechnicalIndicator::Signal::Sell;
+    before = notified;
+    scheduler.getNotificationQueue().push(shortResult);
+    scheduler.getNotificationQueue().push(shortResult);
+    assert(waitFor([&] { return notified == before + 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(notified == before + 1);
+    
+    scheduler.stop();
+    std::cout << "PASSED\n";
+}
+
+// Test 21: Parameter-Grid Engine
+void testIndicatorGrid() {
+    std::cout << "Test 21: Parameter-Grid Engine... ";
+    
+    std::vector<TechnicalIndicator::StockData> stocks(3);
+    for (size_t s = 0; s < stocks.size(); ++s) {
+        stocks[s].symbol = "GRID" + std::to_string(s);
+        size_t length = 120 + s * 97;
+        for (size_t t = 0; t < length; ++t) {
+            stocks[s].prices.push_back(100.0 + std::sin(t * 0.07 * (s + 1)) * 8.0 + t * 0.05);
+        }
+    }
+    stocks.push_back({"GRIDSHORT", {101.0, 102.0, 100.5}, {}, {}});
+    
+    // 20 RSI periods and 18 MACD specs span two parameter blocks
+    IndicatorGrid::Spec spec;
+    spec.smaPeriods = {5, 10, 20, 50, 200};
+    for (int period = 5; period <= 24; ++period) {
+        spec.rsiPeriods.push_back(period);
+    }
+    for (int fast = 8; fast <= 13; ++fast) {
+        for (int slow : {21, 26, 30}) {
+            spec.macdParams.push_back({fast, slow, 9});
+        }
+    }
+    IndicatorGrid grid(spec);
+    auto result = grid.compute(stocks);
+    assert(result.symbols == 4 && result.combinations() == 5 * 5 * 20 * 18);
+    
+    // The default combination matches the last bar of the series kernels
+    size_t sma20 = 2, sma50 = 3, rsi14 = 9, macdDefault = 4 * 3 + 1;
+    assert(spec.rsiPeriods[rsi14] == 14 && spec.macdParams[macdDefault].fast == 12 &&
+           spec.macdParams[macdDefault].slow == 26);
+    TechnicalIndicator indicator;
+    for (size_t s = 0; s < stocks.size(); ++s) {
+        size_t n = stocks[s].prices.size();
+        std::vector<double> sma20Out(n), sma50Out(n), rsiOut(n), macdOut(n), signalOut(n);
+        indicator.computeIndicatorSeries(stocks[s], {sma20Out.data(), sma50Out.data(),
+                                                     rsiOut.data(), macdOut.data(),
+                                                     signalOut.data()});
+        assert(std::abs(result.smaAt(s, sma20) - sma20Out[n - 1]) < 1e-9);
+        assert(std::abs(result.smaAt(s, sma50) - sma50Out[n - 1]) < 1e-9);
+        assert(result.rsiAt(s, rsi14) == rsiOut[n - 1]);
+        assert(result.macdAt(s, macdDefault) == macdOut[n - 1]);
+        assert(result.macdSignalAt(s, macdDefault) == signalOut[n - 1]);
+        
+        auto combined = IndicatorGrid::combination(result, s, 0, sma20, sma50, rsi14, macdDefault);
+        assert(combined.signal == TechnicalIndicator::classifySignal(
+            sma20Out[n - 1], sma50Out[n - 1], rsiOut[n - 1], macdOut[n - 1], signalOut[n - 1]));
+    }
+    
+    // Other parameters against direct definitions
+    const auto& prices = stocks[2].prices;
+    size_t n = prices.size();
+    double sum = 0.0;
+    for (size_t t = n - 200; t < n; ++t) sum += prices[t];
+    assert(std::abs(result.smaAt(2, 4) - sum / 200) < 1e-9);
+    assert(result.smaAt(0, 4) == 0.0);  // 120 bars < 200
+    
+    const IndicatorGrid::MacdParams& params = spec.macdParams[17];  // 13/30/9
+    double fast = prices[0], slow = prices[0], signal = 0.0, macd = 0.0;
+    for (size_t t = 1; t < n; ++t) {
+        fast = (prices[t] - fast) * (2.0 / (params.fast + 1)) + fast;
+        slow = (prices[t] - slow) * (2.0 / (params.slow + 1)) + slow;
+        if (t + 1 < static_cast<size_t>(params.slow)) continue;
+        macd = fast - slow;
+        signal = (t + 1 == static_cast<size_t>(params.slow))
+                     ? macd : (macd - signal) * (2.0 / (params.signal + 1)) + signal;
+    }
+    assert(approxEqual(result.macdAt(2, 17), macd, 1e-12));
+    assert(approxEqual(result.macdSignalAt(2, 17), signal, 1e-12));
+    
+    // Warm-up values for a series shorter than every window
+    assert(result.smaAt(3, 0) == 0.0 && result.rsiAt(3, 0) == 50.0);
+    assert(result.macdAt(3, 0) == 0.0 && result.macdSignalAt(3, 0) == 0.0);
+    
+    bool threw = false;
+    try {
+        IndicatorGrid bad({{20, 0}, {}, {}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 22: Walk-Forward Backtester
+void testBacktester() {
+    std::cout << "Test 22: Walk-Forward Backtester... ";
+    
+    std::vector<TechnicalIndicator::StockData> stocks(5);
+    for (size_t s = 0; s < stocks.size(); ++s) {
+        stocks[s].symbol = "BT" + std::to_string(s);
+        double price = 100.0;
+        for (size_t t = 0; t < 600 + 50 * s; ++t) {
+            price *= 1.0 + 0.02 * std::sin(t * 0.05 * (s + 1)) + 0.001 * std::cos(t * 0.9);
+            stocks[s].prices.push_back(price);
+        }
+    }
+    
+    // Reference: long-only, all-in, no costs, replayed from the full-series
+    // kernel with the one-bar fill delay
+    Backtester backtester;
+    Backtester::Params plain;
+    plain.costBps = 0.0;
+    const auto& prices = stocks[0].prices;
+    size_t n = prices.size();
+    std::vector<double> sma20(n), sma50(n), rsi(n), macd(n), signal(n);
+    TechnicalIndicator indicator;
+    indicator.computeIndicatorSeries(stocks[0], {sma20.data(), sma50.data(), rsi.data(),
+                                                 macd.data(), signal.data()});
+    double cash = plain.initialCapital, shares = 0.0;
+    int pending = -1;
+    size_t trades = 0;
+    for (size_t t = 0; t < n; ++t) {
+        if (pending == 1 && shares == 0.0) {
+            shares = cash / prices[t];
+            cash = 0.0;
+        } else if (pending == 0 && shares > 0.0) {
+            cash = shares * prices[t];
+            shares = 0.0;
+            ++trades;
+        }
+        pending = -1;
+        if (t + 1 == n || t + 1 < plain.warmupBars) continue;
+        auto s = TechnicalIndicator::classifySignal(sma20[t], sma50[t], rsi[t], macd[t], signal[t]);
+        if (s == TechnicalIndicator::Signal::Buy) pending = 1;
+        if (s == TechnicalIndicator::Signal::Sell) pending = 0;
+    }
+    if (shares > 0.0) {
+        cash = shares * prices[n - 1];
+        ++trades;
+    }
+    Backtester::Report report = backtester.run(
+        TechnicalIndicator::PriceSeriesView{stocks[0].symbol, prices.data(), nullptr, nullptr, n},
+        plain);
+    assert(trades > 2 && report.trades == trades);
+    assert(std::abs(report.finalEquity - cash) < 1e-6 * cash);
+    assert(std::abs(report.pnl - (report.finalEquity - plain.initialCapital)) < 1e-9);
+    assert(report.maxDrawdown >= 0.0 && report.maxDrawdown < 1.0);
+    assert(report.hitRate() >= 0.0 && report.hitRate() <= 1.0);
+    assert(report.costs == 0.0 && report.bars == n);
+    
+    // Same trades with costs, strictly less equity
+    Backtester::Params costly = plain;
+    costly.costBps = 10.0;
+    Backtester::Report charged = backtester.run(
+        TechnicalIndicator::PriceSeriesView{stocks[0].symbol, prices.data(), nullptr, nullptr, n},
+        costly);
+    assert(charged.trades == report.trades && charged.costs > 0.0);
+    assert(charged.finalEquity < report.finalEquity);
+    
+    // Parallel (symbol x parameter block) run matches single runs
+    std::vector<Backtester::Params> grid;
+    for (int i = 0; i < 10; ++i) {
+        Backtester::Params params;
+        params.costBps = i;
+        params.positionFraction = 0.5 + 0.05 * i;
+        params.allowShort = (i % 2) == 1;
+        params.sizing = i >= 5 ? Backtester::Sizing::StrengthScaled : Backtester::Sizing::Fixed;
+        grid.push_back(params);
+    }
+    auto reports = backtester.run(stocks, grid);
+    assert(reports.size() == stocks.size() * grid.size());
+    for (size_t s = 0; s < stocks.size(); ++s) {
+        TechnicalIndicator::PriceSeriesView view{stocks[s].symbol, stocks[s].prices.data(),
+                                                 nullptr, nullptr, stocks[s].prices.size()};
+        for (size_t p = 0; p < grid.size(); ++p) {
+            const Backtester::Report& r = reports[s * grid.size() + p];
+            Backtester::Report single = backtester.run(view, grid[p]);
+            assert(r.params == p && r.symbolId == SymbolTable::global().find(stocks[s].symbol));
+            assert(r.finalEquity == single.finalEquity && r.trades == single.trades);
+            assert(r.maxDrawdown == single.maxDrawdown);
+        }
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 23: Cross-Sectional Correlation
+void testCorrelationEngine() {
+    std::cout << "Test 23: Cross-Sectional Correlation... ";
+    
+    // 70 symbols: one full 64-wide tile plus a ragged one, and a partial
+    // 4x4 block at the edge
+    const size_t numSymbols = 70, window = 30, extra = 45;
+    std::vector<TechnicalIndicator::StockData> stocks(numSymbols);
+    for (size_t s = 0; s < numSymbols; ++s) {
+        stocks[s].symbol = "COR" + std::to_string(s);
+        double price = 50.0 + s;
+        for (size_t t = 0; t < window + 1 + extra; ++t) {
+            double market = std::sin(t * 0.7) * 0.01;
+            double own = std::sin(t * (0.3 + 0.05 * s) + s) * 0.01;
+            price *= 1.0 + market * (s % 3) + own;
+            stocks[s].prices.push_back(price);
+        }
+    }
+    
+    auto naiveCovariance = [&](size_t i, size_t j, size_t end) {
+        std::vector<double> ri, rj;
+        for (size_t t = end - window; t < end; ++t) {
+            ri.push_back(stocks[i].prices[t] / stocks[i].prices[t - 1] - 1.0);
+            rj.push_back(stocks[j].prices[t] / stocks[j].prices[t - 1] - 1.0);
+        }
+        double mi = 0, mj = 0;
+        for (size_t k = 0; k < window; ++k) { mi += ri[k]; mj += rj[k]; }
+        mi /= window; mj /= window;
+        double c = 0;
+        for (size_t k = 0; k < window; ++k) c += (ri[k] - mi) * (rj[k] - mj);
+        return c / (window - 1);
+    };
+    
+    // Full compute on the first window+1 closes
+    std::vector<TechnicalIndicator::StockData> head = stocks;
+    for (auto& stock : head) stock.prices.resize(window + 1);
+    CorrelationEngine engine(window);
+    engine.compute(head);
+    assert(engine.size() == numSymbols);
+    for (size_t i = 0; i < numSymbols; i += 3) {
+        for (size_t j = 0; j < numSymbols; j += 5) {
+            double expected = naiveCovariance(i, j, window + 1);
+            assert(std::abs(engine.covariance(i, j) - expected) < 1e-12);
+            assert(engine.covariance(i, j) == engine.covariance(j, i));
+        }
+        assert(approxEqual(engine.correlation(i, i), 1.0, 1e-12));
+    }
+    
+    // Rolling updates (crossing one rebuild) agree with a fresh compute
+    for (size_t t = window + 1; t < window + 1 + extra; ++t) {
+        std::vector<double> closes(numSymbols);
+        for (size_t s = 0; s < numSymbols; ++s) closes[s] = stocks[s].prices[t];
+        engine.update(closes);
+    }
+    CorrelationEngine fresh(window);
+    fresh.compute(stocks);
+    auto rolled = engine.correlationMatrix();
+    auto direct = fresh.correlationMatrix();
+    for (size_t k = 0; k < rolled.size(); ++k) {
+        assert(std::abs(rolled[k] - direct[k]) < 1e-9);
+        assert(rolled[k] >= -1.0 - 1e-12 && rolled[k] <= 1.0 + 1e-12);
+    }
+    size_t end = window + 1 + extra;
+    assert(std::abs(engine.covariance(69, 2) - naiveCovariance(69, 2, end)) < 1e-12);
+    assert(std::abs(engine.covarianceMatrix()[5 * numSymbols + 66] -
+                    naiveCovariance(5, 66, end)) < 1e-12);
+    
+    bool threw = false;
+    try {
+        CorrelationEngine tooLong(200);
+        tooLong.compute(stocks);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 24: Fused Extended Indicators
+void testExtendedIndicators() {
+    std::cout << "Test 24: Fused Extended Indicators... ";
+    
+    TechnicalIndicator::StockData stock;
+    stock.symbol = "EXT";
+    for (size_t t = 0; t < 200; ++t) {
+        stock.prices.push_back(100.0 + std::sin(t * 0.2) * 6.0 + std::cos(t * 1.3));
+        stock.volumes.push_back(1000.0 + (t % 7) * 150.0);
+    }
+    const auto& p = stock.prices;
+    const auto& v = stock.volumes;
+    size_t n = p.size();
+    
+    TechnicalIndicator indicator;
+    auto ext = indicator.computeExtendedIndicators(stock);
+    assert(TechnicalIndicator::symbolName(ext.symbolId) == "EXT");
+    
+    // Bollinger: separate two-pass mean and deviation over the last 20
+    double mean = 0.0;
+    for (size_t t = n - 20; t < n; ++t) mean += p[t];
+    mean /= 20;
+    double var = 0.0;
+    for (size_t t = n - 20; t < n; ++t) var += (p[t] - mean) * (p[t] - mean);
+    double sd = std::sqrt(var / 20);
+    assert(approxEqual(ext.bollinger_middle, indicator.calculateSMA(p.data(), n, 20), 1e-9));
+    assert(approxEqual(ext.bollinger_upper, mean + 2 * sd, 1e-9));
+    assert(approxEqual(ext.bollinger_lower, mean - 2 * sd, 1e-9));
+    
+    // ATR (close-to-close) with Wilder smoothing, OBV, VWAP
+    double atr = 0.0, obv = 0.0;
+    for (size_t t = 1; t <= 14; ++t) atr += std::abs(p[t] - p[t - 1]);
+    atr /= 14;
+    for (size_t t = 15; t < n; ++t) atr = (atr * 13 + std::abs(p[t] - p[t - 1])) / 14;
+    for (size_t t = 1; t < n; ++t) obv += p[t] > p[t - 1] ? v[t] : (p[t] < p[t - 1] ? -v[t] : 0.0);
+    double pv = 0.0, vol = 0.0;
+    for (size_t t = n - 20; t < n; ++t) { pv += p[t] * v[t]; vol += v[t]; }
+    assert(approxEqual(ext.atr, atr, 1e-12));
+    assert(ext.obv == obv);
+    assert(approxEqual(ext.vwap, pv / vol, 1e-9));
+    
+    // Stochastic %K over 14 closes, %D as the 3-bar mean of %K
+    auto percentK = [&](size_t end) {
+        double hi = *std::max_element(p.begin() + end - 13, p.begin() + end + 1);
+        double lo = *std::min_element(p.begin() + end - 13, p.begin() + end + 1);
+        return 100.0 * (p[end] - lo) / (hi - lo);
+    };
+    assert(approxEqual(ext.stochastic_k, percentK(n - 1), 1e-9));
+    assert(approxEqual(ext.stochastic_d, (percentK(n - 1) + percentK(n - 2) + percentK(n - 3)) / 3,
+                       1e-9));
+    assert(ext.stochastic_k >= 0.0 && ext.stochastic_k <= 100.0);
+    
+    // Warm-up and missing volumes
+    TechnicalIndicator::StockData shortStock{"EXTSHORT", {10.0, 11.0, 10.5, 12.0}, {}, {}};
+    auto warm = indicator.computeExtendedIndicators(shortStock);
+    assert(warm.bollinger_middle == 0.0 && warm.atr == 0.0 && warm.obv == 0.0);
+    assert(warm.stochastic_k == 50.0 && warm.stochastic_d == 50.0);
+    assert(approxEqual(warm.vwap, 43.5 / 4, 1e-12));
+    
+    // %D stays at its warm-up value until three real %K values exist
+    for (size_t length : {14u, 15u, 16u}) {
+        TechnicalIndicator::StockData head{"EXTHEAD", {p.begin(), p.begin() + length}, {}, {}};
+        auto partial = indicator.computeExtendedIndicators(head);
+        assert(approxEqual(partial.stochastic_k, percentK(length - 1), 1e-9));
+        double expectedD = length < 16 ? 50.0
+            : (percentK(13) + percentK(14) + percentK(15)) / 3;
+        assert(approxEqual(partial.stochastic_d, expectedD, 1e-9));
+    }
+    
+    // Parallel path matches
+    std::vector<TechnicalIndicator::StockData> stocks = {stock, shortStock};
+    auto batch = indicator.computeExtendedIndicatorsParallel(stocks);
+    assert(batch[0].atr == ext.atr && batch[0].vwap == ext.vwap && batch[1].vwap == warm.vwap);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 25: Compile-Time Indicator Pipeline
+void testIndicatorPipeline() {
+    std::cout << "Test 25: Compile-Time Indicator Pipeline... ";
+    
+    using Full = IndicatorPipeline<SMA<20>, SMA<50>, RSI<14>, MACD<12, 26, 9>>;
+    using Momentum = IndicatorPipeline<RSI<14>, SMA<20>>;
+    static_assert(Full::kLookback == 50 && Momentum::kLookback == 20, "lookback is the widest stage");
+    static_assert(MACD<12, 26, 9>::kLookback == 34, "MACD needs Slow + Signal - 1 bars");
+    static_assert(std::tuple_size<decltype(Momentum::Result::values)>::value == 2,
+                  "result holds only the selected stages");
+    
+    // Long, mid-length (MACD but no SMA50), short and flat series, and one
+    // shorter than the MACD window
+    std::vector<TechnicalIndicator::StockData> stocks;
+    for (size_t length : {200u, 40u, 12u, 0u, 30u}) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = "PIPE" + std::to_string(length);
+        for (size_t t = 0; t < length; ++t) {
+            stock.prices.push_back(100.0 + std::sin(t * 0.3) * 5.0 + (t % 4) * 0.25);
+        }
+        stocks.push_back(stock);
+    }
+    stocks.push_back({"PIPEUP", std::vector<double>(60, 0.0), {}, {}});
+    for (size_t t = 0; t < 60; ++t) stocks.back().prices[t] = 50.0 + t;
+    
+    // SMA and RSI as the snapshot path, MACD as the last bar of the series
+    // path over the trailing 34 bars, bit for bit
+    TechnicalIndicator indicator;
+    auto full = indicator.computeIndicatorsParallel<Full>(stocks);
+    assert(full.size() == stocks.size());
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        auto expected = indicator.computeIndicators(stocks[i]);
+        assert(full[i].symbolId == expected.symbolId);
+        assert((full[i].get<SMA<20>>() == expected.sma_20));
+        assert((full[i].get<SMA<50>>() == expected.sma_50));
+        assert((full[i].get<RSI<14>>() == expected.rsi));
+        
+        const auto& p = stocks[i].prices;
+        size_t window = std::min<size_t>(p.size(), 34);
+        auto macd = full[i].get<MACD<12, 26, 9>>();
+        if (window == 0) {
+            assert(macd.macd == 0.0 && macd.signal == 0.0);
+            continue;
+        }
+        std::vector<double> sma20(window), sma50(window), rsi(window), line(window), signal(window);
+        TechnicalIndicator::IndicatorSeries series{sma20.data(), sma50.data(), rsi.data(),
+                                                   line.data(), signal.data()};
+        indicator.computeIndicatorSeries(p.data() + p.size() - window, window, series);
+        assert(macd.macd == line[window - 1]);
+        assert(macd.signal == signal[window - 1]);
+    }
+    assert((full[5].get<RSI<14>>() == 100.0));
+    assert((full[2].get<MACD<12, 26, 9>>().macd == 0.0));
+    auto trending = full[0].get<MACD<12, 26, 9>>();
+    assert(trending.signal != trending.macd * 0.9);
+    
+    // Subsets and other windows, through the view overload
+    std::vector<TechnicalIndicator::PriceSeriesView> views;
+    for (const auto& s : stocks) {
+        views.push_back({s.symbol, s.prices.data(), nullptr, nullptr, s.prices.size()});
+    }
+    auto momentum = indicator.computeIndicatorsParallel<Momentum>(views);
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        assert((momentum[i].get<RSI<14>>() == full[i].get<RSI<14>>()));
+        assert((momentum[i].get<SMA<20>>() == full[i].get<SMA<20>>()));
+    }
+    const auto& p = stocks[0].prices;
+    auto custom = IndicatorPipeline<SMA<7>, RSI<30>>::compute(stocks[0]);
+    assert(approxEqual(custom.get<SMA<7>>(), indicator.calculateSMA(p.data(), p.size(), 7), 1e-12));
+    assert(approxEqual(custom.get<RSI<30>>(), indicator.calculateRSI(p.data(), p.size(), 30), 1e-12));
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 26: NUMA Topology and Node-Partitioned Compute
+void testNumaEngine() {
+    std::cout << "Test 26: NUMA Topology and Node-Partitioned Compute... ";
+    
+    assert((NumaTopology::parseCpuList("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    assert(NumaTopology::parseCpuList("").empty());
+    bool threw = false;
+    try {
+        NumaTopology::parseCpuList("3-1");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Fake sysfs tree: two CPU nodes, a memory-only node and unrelated files
+    const std::string root = "test_numa_sysfs";
+    std::filesystem::remove_all(root);
+    for (const char* node : {"node0", "node1", "node2"}) {
+        std::filesystem::create_directories(root + "/" + node);
+    }
+    std::ofstream(root + "/node1/cpulist") << "2-3\n";
+    std::ofstream(root + "/node0/cpulist") << "0-1\n";
+    std::ofstream(root + "/node2/cpulist") << "\n";
+    std::ofstream(root + "/possible") << "0-2\n";
+    auto raw = NumaTopology::fromSysfs(root);
+    std::filesystem::remove_all(root);
+    assert(raw.size() == 3 && raw.nodes()[0].id == 0 && raw.nodes()[1].id == 1);
+    assert((raw.nodes()[1].cpus == std::vector<int>{2, 3}));
+    
+    auto restricted = raw.restrictedTo({0, 1, 2});
+    assert(restricted.size() == 2 && restricted.cpuCount() == 3 && restricted.isMultiNode());
+    auto oneNode = raw.restrictedTo({1});
+    assert(oneNode.size() == 1 && oneNode.nodes()[0].id == 0 && !oneNode.isMultiNode());
+    
+    // Missing sysfs degrades to one node with every allowed CPU
+    auto fallback = NumaTopology::fromSysfs("no_such_sysfs").restrictedTo(NumaTopology::allowedCpus());
+    assert(fallback.size() == 1 && fallback.cpuCount() == NumaTopology::allowedCpus().size());
+    
+    // So does a malformed cpulist or node number, instead of throwing
+    for (const auto& bad : {std::make_pair("node1", "2-x\n"), std::make_pair("node99999999999", "4\n")}) {
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root + "/node0");
+        std::filesystem::create_directories(root + "/" + bad.first);
+        std::ofstream(root + "/node0/cpulist") << "0-1\n";
+        std::ofstream(root + "/" + bad.first + "/cpulist") << bad.second;
+        auto parsed = NumaTopology::fromSysfs(root);
+        assert(parsed.size() == 0);
+        auto degraded = parsed.restrictedTo(NumaTopology::allowedCpus());
+        assert(degraded.size() == 1 && degraded.cpuCount() == NumaTopology::allowedCpus().size());
+    }
+    std::filesystem::remove_all(root);
+    assert(NumaTopology::detect().size() >= 1);
+    
+    std::vector<TechnicalIndicator::StockData> stocks;
+    for (int s = 0; s < 300; ++s) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = "NUMA" + std::to_string(s);
+        for (int t = 0; t < 20 + (s * 7) % 120; ++t) {
+            stock.prices.push_back(100.0 + std::sin((s + t) * 0.1) * 4.0 + (t % 3));
+        }
+        stocks.push_back(stock);
+    }
+    TechnicalIndicator indicator;
+    auto expected = indicator.computeIndicatorsParallel(stocks);
+    
+    // Two nodes sharing the CPUs this process may use, so pinning succeeds
+    // even on a single-socket machine
+    auto cpus = NumaTopology::allowedCpus();
+    NumaIndicatorEngine engine(NumaTopology::fromNodes({{0, cpus}, {1, cpus}}));
+    engine.load(stocks);
+    auto results = engine.compute();
+    assert(results == expected);
+    
+    size_t symbols = 0, bars = 0, totalBars = 0;
+    for (const auto& s : stocks) totalBars += s.prices.size();
+    for (const auto& node : engine.nodeStats()) {
+        assert(node.pinned && node.symbols > 0 && node.seconds > 0.0);
+        symbols += node.symbols;
+        bars += node.bars;
+    }
+    assert(symbols == stocks.size() && bars == totalBars);
+    
+    NumaIndicatorEngine local(NumaTopology::singleNode(cpus));
+    local.load(stocks);
+    assert(local.compute() == expected);
+    assert(local.nodeStats().size() == 1 && !local.nodeStats()[0].pinned);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 27: Scratch Arena and Allocation-Free Hot Paths
+void testScratchArena() {
+    std::cout << "Test 27: Scratch Arena and Allocation-Free Hot Paths... ";
+    
+    ScratchArena arena;
+    double* first = arena.allocateArray<double>(100);
+    assert(reinterpret_cast<uintptr_t>(first) % alignof(double) == 0);
+    auto marker = arena.mark();
+    double* big = arena.allocateArray<double>(ScratchArena::kBlockSize);  // needs its own block
+    assert(big != nullptr && arena.blockAllocations() == 2);
+    arena.rewind(marker);
+    assert(arena.allocateArray<double>(10) == first + 100);
+    {
+        ScratchArena::Scope scope(arena);
+        arena.allocate(1000, 64);
+        ScratchVector<int> values{ScratchAllocator<int>(arena)};
+        values.reserve(100);
+        for (int i = 0; i < 100; ++i) values.push_back(i);
+        assert(values[99] == 99);
+    }
+    assert(arena.bytesUsed() == 110 * sizeof(double));
+    arena.reset();
+    assert(arena.bytesUsed() == 0 && arena.blockAllocations() == 2);
+    
+    // Warm once (interning, arena blocks), then the hot paths must not allocate
+    TechnicalIndicator::StockData stock;
+    stock.symbol = "ARENA";
+    for (int t = 0; t < 300; ++t) stock.prices.push_back(100.0 + std::sin(t * 0.05) * 10.0);
+    std::vector<TechnicalIndicator::StockData> stocks(8, stock);
+    TechnicalIndicator indicator;
+    IndicatorGrid grid({{5, 10, 20, 50}, {7, 14, 21}, {{12, 26, 9}, {5, 35, 5}}});
+    Backtester backtester;
+    std::vector<Backtester::Params> params(3);
+    TechnicalIndicator::PriceSeriesView view{stock.symbol, stock.prices.data(), nullptr, nullptr,
+                                             stock.prices.size()};
+    std::vector<TechnicalIndicator::IndicatorResult> results(stocks.size());
+    auto grid1 = grid.compute(stocks);
+    backtester.run(stocks, params);
+    indicator.computeIndicators(stock);
+    
+    size_t before = gHeapAllocations.load();
+    double sink = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        sink += indicator.calculateRSI(stock.prices.data(), stock.prices.size(), 14);
+        sink += indicator.computeIndicators(view).macd;
+        sink += indicator.computeIndicators(stock).rsi;
+        sink += indicator.computeExtendedIndicators(view).atr;
+        sink += backtester.run(view, params[0]).pnl;
+    }
+    assert(gHeapAllocations.load() == before);
+    
+    // Batch paths allocate their outputs only, never per task
+    size_t warmBlocks = ScratchArena::local().blockAllocations();
+    before = gHeapAllocations.load();
+    auto grid2 = grid.compute(stocks);
+    size_t gridAllocations = gHeapAllocations.load() - before;
+    assert(gridAllocations <= 5);  // views plus the four result arrays
+    assert(grid2.rsi == grid1.rsi && grid2.macdSignal == grid1.macdSignal);
+    assert(ScratchArena::local().blockAllocations() == warmBlocks);
+    assert(ScratchArena::local().bytesUsed() == 0);
+    assert(sink != 0.0);
+    
+    std::cout << "PASSED\n";
+}
+
+// Test 28: Single and Mixed Precision Accuracy Bounds
+void testPrecisionModes() {
+    std::cout << "Test 28: Single and Mixed Precision Accuracy Bounds... ";
+    
+    // Universe with full lane groups, a partial group and short series
+    std::vector<TechnicalIndicator::StockData> stocks;
+    for (int s = 0; s < 37; ++s) {
+        TechnicalIndicator::StockData stock;
+        stock.symbol = "PREC" + std::to_string(s);
+        int length = s == 5 ? 10 : (s == 6 ? 0 : 60 + s * 13);
+        for (int t = 0; t < length; ++t) {
+            stock.prices.push_back(50.0 + s + std::sin((s + 1) * t * 0.07) * 3.0);
+        }
+        stocks.push_back(stock);
+    }
+    auto doubleStore = ColumnarPriceStore::fromStockData(stocks);
+    auto floatStore = FloatPriceStore::fromStockData(stocks);
+    assert(floatStore.totalPrices() == doubleStore.totalPrices());
+    assert(floatStore.arena().size() * sizeof(float) * 2 ==
+           doubleStore.arena().size() * sizeof(double));
+    
+    // The double instantiation is the reference path itself
+    TechnicalIndicator indicator;
+    auto reference = indicator.computeIndicatorsParallel(stocks);
+    auto scanned = PrecisionIndicators<DoublePrecision>::computeParallel(doubleStore);
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        assert(scanned[i] == reference[i]);
+    }
+    
+    // Lane-blocked scans equal the scalar kernels of the same precision
+    auto mixed = PrecisionIndicators<MixedPrecision>::computeParallel(floatStore);
+    auto single = PrecisionIndicators<SinglePrecision>::computeParallel(floatStore);
+    static_assert(PrecisionIndicators<SinglePrecision>::kLanes ==
+                  2 * PrecisionIndicators<MixedPrecision>::kLanes, "float doubles the lanes");
+    for (size_t i = 0; i < stocks.size(); ++i) {
+        const float* prices = floatStore.prices(i);
+        size_t length = floatStore.length(i);
+        assert(mixed[i] == PrecisionIndicators<MixedPrecision>::compute(floatStore.symbolId(i), prices, length));
+        assert(single[i] == PrecisionIndicators<SinglePrecision>::compute(floatStore.symbolId(i), prices, length));
+        assert(std::abs(mixed[i].rsi - reference[i].rsi) < 1e-3);
+        assert(std::abs(single[i].sma_50 - reference[i].sma_50) < 1e-4 * (1.0 + reference[i].sma_50));
+    }
+    
+    // 200k-bar random walk that falls by orders of magnitude: the worst
+    // case for running sums, which must still track the double path
+    const size_t n = 200000;
+    std::mt19937 gen(7);
+    std::vector<double> prices(n);
+    double price = 100.0;
+    for (size_t t = 0; t < n; ++t) {
+        price *= 1.0 + (gen() / 4294967296.0 - 0.5) * 0.035;
+        prices[t] = price;
+    }
+    std::vector<float> rounded(prices.begin(), prices.end());
+    
+    std::vector<double> sma20(n), sma50(n), rsi(n), macd(n), signal(n);
+    indicator.computeIndicatorSeries(prices.data(), n,
+                                     {sma20.data(), sma50.data(), rsi.data(), macd.data(), signal.data()});
+    
+    auto maxDeviation = [&](auto precision, double bounds[3]) {
+        using Kernels = PrecisionIndicators<decltype(precision)>;
+        std::vector<float> a(n), b(n), c(n), d(n), e(n);
+        Kernels::computeSeries(rounded.data(), n,
+                               typename Kernels::Series{a.data(), b.data(), c.data(), d.data(), e.data()});
+        for (size_t t = 50; t < n; ++t) {
+            bounds[0] = std::max({bounds[0], std::abs(a[t] - sma20[t]) / sma20[t],
+                                  std::abs(b[t] - sma50[t]) / sma50[t]});
+            bounds[1] = std::max(bounds[1], std::abs(c[t] - rsi[t]));
+            bounds[2] = std::max({bounds[2], std::abs(d[t] - macd[t]) / sma50[t],
+                                  std::abs(e[t] - signal[t]) / sma50[t]});
+        }
+        assert(std::abs(Kernels::rsi(rounded.data(), n) - indicator.calculateRSI(prices.data(), n)) < 1e-3);
+        assert(std::abs(Kernels::sma(rounded.data(), n, 50) - sma50[n - 1]) < 1e-5 * sma50[n - 1]);
+    };
+    double mixedBounds[3] = {0, 0, 0};
+    double singleBounds[3] = {0, 0, 0};
+    maxDeviation(MixedPrecision{}, mixedBounds);
+    maxDeviation(SinglePrecision{}, singleBounds);
+    assert(prices[n - 1] < 1.0);  // the walk really did fall
+    
+    // SMA relative, RSI in points, MACD relative to price
+    assert(mixedBounds[0] < 5e-7 && mixedBounds[1] < 1e-3 && mixedBounds[2] < 1e-7);
+    assert(singleBounds[0] < 1e-5 && singleBounds[1] < 1e-3 && singleBounds[2] < 5e-6);
     
     std::cout << "PASSED\n";
 }
@@ -175,6 +1935,28 @@ int main() {
         testSignalGeneration();
         testParallelConsistency();
         testEdgeCases();
+        testColumnarBatch();
+        testSimdDifferential();
+        testIncrementalIndicator();
+        testIndicatorSeries();
+        testRingQueues();
+        testWorkStealingPool();
+        testBinaryHistory();
+        testCsvIngestion();
+        testSymbolInterning();
+        testLatencyHistogram();
+        testTimerQueue();
+        testSnapshotCache();
+        testBoundedRetention();
+        testDirtyTracking();
+        testIndicatorGrid();
+        testBacktester();
+        testCorrelationEngine();
+        testExtendedIndicators();
+        testIndicatorPipeline();
+        testNumaEngine();
+        testScratchArena();
+        testPrecisionModes();
         
         std::cout << "\n=== All Tests PASSED ===\n";
         return 0;
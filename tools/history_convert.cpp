@@ -0,0 +1,119 @@
+#include "../include/BinaryHistory.h"
+#include "../include/StockDataFetcher.h"
+#include "../include/TechnicalIndicator.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage:\n"
+              << "  " << program << " synthetic <num_symbols> <bars_per_symbol> <out.bin>\n"
+              << "  " << program << " csv <in.csv> <out.bin>\n"
+              << "  " << program << " info <file.bin>\n";
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int writeSynthetic(int numSymbols, int bars, const std::string& outPath) {
+    std::mt19937 gen(7);
+    std::normal_distribution<double> returns(0.0, 0.01);
+    std::uniform_real_distribution<double> volumeDist(1000000.0, 10000000.0);
+
+    std::vector<TechnicalIndicator::StockData> stocks(numSymbols);
+    for (int i = 0; i < numSymbols; ++i) {
+        auto& stock = stocks[i];
+        stock.symbol = "SYM" + std::to_string(i);
+        double price = 100.0;
+        for (int day = 0; day < bars; ++day) {
+            price *= 1.0 + returns(gen);
+            stock.prices.push_back(price);
+            stock.volumes.push_back(volumeDist(gen));
+            stock.timestamps.push_back(day);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    BinaryHistory::write(outPath, stocks);
+    std::cout << "Wrote " << numSymbols << " symbols x " << bars << " bars to " << outPath
+              << " in " << std::fixed << std::setprecision(3) << secondsSince(start) << " s\n";
+    return 0;
+}
+
+int convertCsv(const std::string& inPath, const std::string& outPath) {
+    StockDataFetcher fetcher;
+    StockDataFetcher::IngestStats stats;
+    auto stocks = fetcher.loadCsv(inPath, &stats);
+
+    auto start = std::chrono::steady_clock::now();
+    BinaryHistory::write(outPath, stocks);
+    double writeSeconds = secondsSince(start);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Parsed " << stats.rows << " rows (" << stats.skippedRows << " skipped), "
+              << stats.symbols << " symbols on " << stats.threads << " threads in "
+              << stats.seconds << " s\n"
+              << "Ingest:    " << std::setprecision(0) << stats.rowsPerSecond() << " rows/s, "
+              << std::setprecision(1) << stats.megabytesPerSecond() << " MB/s\n"
+              << "Wrote " << outPath << " in " << std::setprecision(3) << writeSeconds << " s\n";
+    return 0;
+}
+
+int showInfo(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    MappedHistory history(path);
+    double mapSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    TechnicalIndicator indicator;
+    auto results = indicator.computeIndicatorsParallel(history.views());
+    double computeSeconds = secondsSince(start);
+
+    std::cout << std::fixed << std::setprecision(6)
+              << "File:      " << path << "\n"
+              << "Symbols:   " << history.size() << "\n"
+              << "Bars:      " << history.totalBars() << "\n"
+              << "Size:      " << history.mappedBytes() / (1024.0 * 1024.0) << " MB\n"
+              << "Map time:  " << mapSeconds << " s\n"
+              << "Analysis:  " << computeSeconds << " s (first touch included)\n";
+    if (!results.empty()) {
+        std::cout << "First:     " << TechnicalIndicator::symbolName(results.front()) << " "
+                  << TechnicalIndicator::signalName(results.front().signal)
+                  << " RSI " << std::setprecision(2) << results.front().rsi << "\n";
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string command = argv[1];
+    try {
+        if (command == "synthetic" && argc == 5) {
+            return writeSynthetic(std::stoi(argv[2]), std::stoi(argv[3]), argv[4]);
+        }
+        if (command == "csv" && argc == 4) {
+            return convertCsv(argv[2], argv[3]);
+        }
+        if (command == "info" && argc == 3) {
+            return showInfo(argv[2]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}